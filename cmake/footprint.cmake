@@ -0,0 +1,226 @@
+# Report the code size and the stack usage of the functions of a library.
+# The objects must be compiled with -ffunction-sections and -fstack-usage.
+# If they are also compiled with -fcallgraph-info=su, the worst-case stack
+# of each function is computed with its callees.
+#
+#   cmake -DOBJECTS=a.c.o|b.c.o -DOBJDUMP=objdump -DNM=nm
+#         [-DREPORT=footprint.txt] [-DFORBID=printf] [-DMAXSTACK=1024]
+#         -P footprint.cmake
+#
+# FORBID is a regular expression. The report fails if an undefined symbol
+# of the objects matches it, e.g. a function of the C library.
+# MAXSTACK is a size in bytes. The report fails if the worst-case stack of
+# an exported function is larger, is in a recursion or has a dynamic frame.
+# Unknown callees are not counted.
+
+string(REPLACE "|" ";" OBJECTS "${OBJECTS}")
+set(report "")
+
+# Add a line to the report.
+macro(out)
+    string(APPEND report "${ARGN}\n")
+endmacro()
+
+# Pad a value on the left to a width.
+function(pad var value width)
+    string(LENGTH "${value}" len)
+    while(len LESS width)
+        string(PREPEND value " ")
+        math(EXPR len "${len} + 1")
+    endwhile()
+    set(${var} "${value}" PARENT_SCOPE)
+endfunction()
+
+# Worst-case stack of each function from the call graphs of all the
+# objects, so calls between objects are followed. Unknown callees, e.g.
+# the C library or calls through pointers, add nothing and are marked.
+set(ids "")
+set(placeholders "")
+set(edges "")
+foreach(obj IN LISTS OBJECTS)
+    string(REGEX REPLACE "\\.o(bj)?$" ".ci" ci "${obj}")
+    if(EXISTS "${ci}")
+        file(READ "${ci}" graph)
+        string(REGEX MATCHALL "node: { title: \"[^\"]*\" label: \"[^\"]*\"" nodes "${graph}")
+        foreach(node IN LISTS nodes)
+            string(REGEX MATCH "title: \"([^\"]*)\" label: \"[^\"]*\\\\n([0-9]+) bytes \\(([a-z,]+)\\)" found "${node}")
+            if(found)
+                string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+                set(frame_${id} ${CMAKE_MATCH_2})
+                set(kind_${id} "")
+                if(CMAKE_MATCH_3 MATCHES "dynamic")
+                    set(kind_${id} "+")
+                endif()
+                list(APPEND ids ${id})
+            else()
+                string(REGEX MATCH "title: \"([^\"]*)\"" _ "${node}")
+                string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+                list(APPEND placeholders ${id})
+            endif()
+        endforeach()
+        string(REGEX MATCHALL "edge: { sourcename: \"[^\"]*\" targetname: \"[^\"]*\"" found "${graph}")
+        list(APPEND edges ${found})
+    endif()
+endforeach()
+foreach(id IN LISTS placeholders)
+    if(NOT DEFINED frame_${id})
+        set(frame_${id} 0)
+        set(kind_${id} "?")
+        list(APPEND ids ${id})
+    endif()
+endforeach()
+list(REMOVE_DUPLICATES ids)
+foreach(id IN LISTS ids)
+    set(callees_${id} "")
+endforeach()
+foreach(edge IN LISTS edges)
+    string(REGEX MATCH "sourcename: \"([^\"]*)\" targetname: \"([^\"]*)\"" _ "${edge}")
+    string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" src)
+    string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_2}" dst)
+    list(APPEND callees_${src} ${dst})
+endforeach()
+foreach(id IN LISTS ids)
+    set(worst_${id} ${frame_${id}})
+    set(mark_${id} "${kind_${id}}")
+endforeach()
+# Relax the graph once per node. It is enough for a graph without cycles.
+# The functions that still change are in a recursion.
+list(LENGTH ids passes)
+foreach(pass RANGE ${passes})
+    set(changed "")
+    foreach(id IN LISTS ids)
+        set(worst ${frame_${id}})
+        set(mark "${kind_${id}}")
+        foreach(callee IN LISTS callees_${id})
+            math(EXPR candidate "${frame_${id}} + ${worst_${callee}}")
+            if(candidate GREATER worst)
+                set(worst ${candidate})
+            endif()
+            if(NOT "${mark_${callee}}" STREQUAL "" AND "${mark}" STREQUAL "")
+                set(mark "${mark_${callee}}")
+            endif()
+        endforeach()
+        if(NOT worst EQUAL worst_${id} OR NOT "${mark}" STREQUAL "${mark_${id}}")
+            set(worst_${id} ${worst})
+            set(mark_${id} "${mark}")
+            list(APPEND changed ${id})
+        endif()
+    endforeach()
+    if(NOT changed)
+        break()
+    endif()
+endforeach()
+foreach(id IN LISTS changed)
+    set(mark_${id} "r")
+endforeach()
+
+foreach(obj IN LISTS OBJECTS)
+    get_filename_component(objname "${obj}" NAME)
+    string(REGEX REPLACE "\\.o(bj)?$" ".su" su "${obj}")
+
+    # Sizes of the sections. With -ffunction-sections each function has
+    # its own .text section.
+    execute_process(COMMAND ${OBJDUMP} -h "${obj}" OUTPUT_VARIABLE headers RESULT_VARIABLE rslt)
+    if(NOT rslt EQUAL 0)
+        message(FATAL_ERROR "${OBJDUMP} failed with ${obj}")
+    endif()
+    foreach(kind text rodata data bss)
+        set(total_${kind} 0)
+    endforeach()
+    string(REGEX MATCHALL "\n +[0-9]+ [^ ]+ +[0-9a-f]+" sections "${headers}")
+    foreach(section IN LISTS sections)
+        string(REGEX MATCH "([^ ]+) +([0-9a-f]+)$" _ "${section}")
+        set(name "${CMAKE_MATCH_1}")
+        math(EXPR size "0x${CMAKE_MATCH_2}")
+        foreach(kind text rodata data bss)
+            if(name MATCHES "^\\.${kind}(\\.|$)")
+                math(EXPR total_${kind} "${total_${kind}} + ${size}")
+            endif()
+        endforeach()
+        if(name MATCHES "^\\.text\\.(.+)$")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+            set(text_${id} ${size})
+        endif()
+    endforeach()
+    out("${objname}: text ${total_text}, rodata ${total_rodata}, data ${total_data}, bss ${total_bss}")
+
+    # Functions with their stack frames. Static functions of other objects
+    # can have the same names so the frames are read again here.
+    set(functions "")
+    if(EXISTS "${su}")
+        file(STRINGS "${su}" frames)
+        foreach(frame IN LISTS frames)
+            if(frame MATCHES ":([^:\t]+)\t([0-9]+)\t([a-z,]+)$")
+                list(APPEND functions "${CMAKE_MATCH_1}")
+                string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+                set(stack_${id} ${CMAKE_MATCH_2})
+                if(CMAKE_MATCH_3 MATCHES "dynamic")
+                    string(APPEND stack_${id} "+")
+                endif()
+            endif()
+        endforeach()
+    endif()
+
+    # Only the functions exported by the object are reported.
+    execute_process(COMMAND ${NM} -g --defined-only "${obj}" OUTPUT_VARIABLE exported)
+    out("  function                      text  frame  worst")
+    list(SORT functions)
+    list(REMOVE_DUPLICATES functions)
+    foreach(function IN LISTS functions)
+        if(exported MATCHES " T ${function}\n")
+            string(MAKE_C_IDENTIFIER "${function}" id)
+            set(text "${text_${id}}")
+            if(text STREQUAL "")
+                set(text "-")
+            endif()
+            set(worst "-")
+            set(bytes "${stack_${id}}")
+            if(DEFINED worst_${id})
+                set(worst "${worst_${id}}${mark_${id}}")
+                set(bytes "${worst_${id}}${mark_${id}}")
+            endif()
+            if(MAXSTACK AND bytes MATCHES "^([0-9]+)(.*)$")
+                if(CMAKE_MATCH_1 GREATER MAXSTACK OR CMAKE_MATCH_2 MATCHES "[r+]")
+                    set(unbounded "${unbounded} ${function}:${bytes}")
+                endif()
+            endif()
+            string(SUBSTRING "${function}                            " 0 28 name)
+            pad(text "${text}" 6)
+            pad(frame "${stack_${id}}" 7)
+            pad(worst "${worst}" 7)
+            out("  ${name}${text}${frame}${worst}")
+        endif()
+    endforeach()
+
+    # Functions of other objects and of the C library.
+    execute_process(COMMAND ${NM} -u "${obj}" OUTPUT_VARIABLE undefined)
+    string(REGEX MATCHALL "[A-Za-z_][A-Za-z0-9_@.]*\n" undefined "${undefined}")
+    string(REPLACE "\n" "" undefined "${undefined}")
+    list(FILTER undefined EXCLUDE REGEX "^U$")
+    string(REPLACE ";" " " externals "${undefined}")
+    out("  external: ${externals}")
+    if(FORBID)
+        foreach(symbol IN LISTS undefined)
+            if(symbol MATCHES "${FORBID}")
+                set(forbidden "${forbidden} ${objname}:${symbol}")
+            endif()
+        endforeach()
+    endif()
+    out("")
+endforeach()
+
+out("Sizes in bytes. Stack marks: + dynamic, ? unknown callee, r recursion.")
+message("${report}")
+if(REPORT)
+    file(WRITE "${REPORT}" "${report}")
+endif()
+set(errors "")
+if(forbidden)
+    string(APPEND errors "Forbidden symbols:${forbidden}\n")
+endif()
+if(unbounded)
+    string(APPEND errors "Stacks unbounded or larger than ${MAXSTACK} bytes:${unbounded}\n")
+endif()
+if(errors)
+    message(FATAL_ERROR "${errors}")
+endif()
@@ -0,0 +1,120 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "json-maker/json-maker.h"
+
+/* Measure the time to build small documents with many calls. It is built
+   linked with the library and with JSON_MAKER_INLINE defined, and for both
+   JSON text and CBOR with the same serializers. */
+
+struct weather {
+    int temp;
+    int hum;
+};
+
+struct time {
+    int hour;
+    int minute;
+};
+
+struct measure {
+    struct weather weather;
+    struct time time;
+};
+
+/* Add a weather object property in a JSON string.
+  "name":{"temp":-5,"hum":48}, */
+static char* json_weather( char* dest, char const* name, struct weather const* weather, size_t* remLen ) {
+    dest = json_objOpen( dest, name, remLen );
+    dest = json_int( dest, "temp", weather->temp, remLen );
+    dest = json_int( dest, "hum", weather->hum, remLen );
+    dest = json_objClose( dest, remLen );
+    return dest;
+}
+
+/* Add a time object property in a JSON string.
+  "name":{"hour":18,"minute":32}, */
+static char* json_time( char* dest, char const* name, struct time const* time, size_t* remLen ) {
+    dest = json_objOpen( dest, name, remLen );
+    dest = json_int( dest, "hour",   time->hour,   remLen );
+    dest = json_int( dest, "minute", time->minute, remLen );
+    dest = json_objClose( dest, remLen );
+    return dest;
+}
+
+/** Convert a measure structure in a JSON string.
+  * {"weather":{"temp":-5,"hum":48},"time":{"hour":18,"minute":32}}
+  * @param dest Destination memory block.
+  * @param measure Source structure.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int measure_to_json( char* dest, struct measure const* measure, size_t* remLen ) {
+    char* p = json_objOpen( dest, NULL, remLen );
+    p = json_weather( p, "weather", &measure->weather, remLen );
+    p = json_time( p, "time", &measure->time, remLen );
+    p = json_objClose( p, remLen );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Get a monotonic time in nanoseconds. */
+static double now( void ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main( int argc, char** argv ) {
+    long const loops = argc > 1 ? atol( argv[1] ) : 5000000;
+    char buff[128];
+    long bytes = 0;
+    double const start = now();
+    for( long i = 0; i < loops; ++i ) {
+        struct measure const measure = {
+            .weather = { .temp = (int)( i % 60 ) - 20, .hum = (int)( i % 100 ) },
+            .time    = { .hour = (int)( i % 24 ), .minute = (int)( i % 60 ) }
+        };
+        size_t remLen = sizeof buff - 1;
+        bytes += measure_to_json( buff, &measure, &remLen );
+    }
+    double const elapsed = now() - start;
+#ifdef JSON_MAKER_INLINE
+    char const* mode = "inline";
+#else
+    char const* mode = "library";
+#endif
+#ifdef JSON_MAKER_CBOR
+    char const* format = "cbor";
+#else
+    char const* format = "json";
+#endif
+    printf( "%-4s %-8s %ld docs, %ld bytes, %.1f ns/doc\n", format, mode, loops, bytes, elapsed / loops );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "json-maker/json-maker.h"
+#include "json-maker/json-column.h"
+
+/* Compare the columnar serializer with the equivalent loop of chained calls. */
+
+enum { rows = 4096 };
+
+/** Columns of a time series. */
+static long long ts[ rows ];
+static int temp[ rows ];
+static int hum[ rows ];
+static double wind[ rows ];
+
+/** Columns of a wide export of real numbers. */
+enum { reals = 6 };
+static double sensor[ reals ][ rows ];
+
+/** Convert the time series in a JSON string with a loop of chained calls.
+  * @param dest Destination memory block.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int chained_to_json( char* dest, size_t* remLen ) {
+    char* p = json_arrOpen( dest, NULL, remLen );
+    for( int i = 0; i < rows; ++i ) {
+        p = json_objOpen( p, NULL, remLen );
+        p = json_verylong( p, "ts", ts[i], remLen );
+        p = json_int( p, "temp", temp[i], remLen );
+        p = json_int( p, "hum", hum[i], remLen );
+        p = json_double( p, "wind", wind[i], remLen );
+        p = json_objClose( p, remLen );
+    }
+    p = json_arrClose( p, remLen );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Convert the time series in a JSON string with a single call.
+  * @param dest Destination memory block.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int columns_to_json( char* dest, size_t* remLen ) {
+    static struct jsonColumn const cols[] = {
+        { "ts",   'I', ts,   0 },
+        { "temp", 'i', temp, 0 },
+        { "hum",  'i', hum,  0 },
+        { "wind", 'd', wind, 0 },
+    };
+    char* p = json_columns( dest, NULL, cols, sizeof cols / sizeof *cols, rows, remLen );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Convert the real numbers in a JSON string with a loop of chained calls.
+  * @param dest Destination memory block.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int chained_reals( char* dest, size_t* remLen ) {
+    static char const* const names[ reals ] = { "s0", "s1", "s2", "s3", "s4", "s5" };
+    char* p = json_arrOpen( dest, NULL, remLen );
+    for( int i = 0; i < rows; ++i ) {
+        p = json_objOpen( p, NULL, remLen );
+        for( int j = 0; j < reals; ++j )
+            p = json_double( p, names[j], sensor[j][i], remLen );
+        p = json_objClose( p, remLen );
+    }
+    p = json_arrClose( p, remLen );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Convert the real numbers in a JSON string with a single call.
+  * @param dest Destination memory block.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int columns_reals( char* dest, size_t* remLen ) {
+    static struct jsonColumn const cols[ reals ] = {
+        { "s0", 'd', sensor[0], 0 }, { "s1", 'd', sensor[1], 0 }, { "s2", 'd', sensor[2], 0 },
+        { "s3", 'd', sensor[3], 0 }, { "s4", 'd', sensor[4], 0 }, { "s5", 'd', sensor[5], 0 },
+    };
+    char* p = json_columns( dest, NULL, cols, reals, rows, remLen );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Get a monotonic time in nanoseconds. */
+static double now( void ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/** Build many documents and print the time per row. */
+static void bench( char const* title, int(*func)( char*, size_t* ), char* buff, size_t size, long loops ) {
+    long bytes = 0;
+    double const start = now();
+    for( long i = 0; i < loops; ++i ) {
+        size_t remLen = size - 1;
+        bytes += func( buff, &remLen );
+    }
+    double const elapsed = now() - start;
+    printf( "%-8s %ld rows, %ld bytes, %.1f ns/row\n", title, loops * rows, bytes, elapsed / ( loops * rows ) );
+}
+
+int main( int argc, char** argv ) {
+    long const loops = argc > 1 ? atol( argv[1] ) : 200;
+    for( int i = 0; i < rows; ++i ) {
+        ts[i] = 1700000000000ll + i * 1000ll;
+        temp[i] = i % 60 - 20;
+        hum[i] = i % 100;
+        wind[i] = ( i % 250 ) / 10.0;
+        for( int j = 0; j < reals; ++j )
+            sensor[j][i] = ( i * 7919 % 100000 ) / 1000.0 * ( j + 1 ) - 150.25;
+    }
+    static char chained[ rows * 120 ], columns[ rows * 120 ];
+    size_t remLen = sizeof chained - 1;
+    chained_to_json( chained, &remLen );
+    remLen = sizeof columns - 1;
+    columns_to_json( columns, &remLen );
+    if ( 0 != strcmp( chained, columns ) ) {
+        fputs( "Different output.\n", stderr );
+        return EXIT_FAILURE;
+    }
+    bench( "chained", chained_to_json, chained, sizeof chained, loops );
+    bench( "columns", columns_to_json, columns, sizeof columns, loops );
+    remLen = sizeof chained - 1;
+    chained_reals( chained, &remLen );
+    remLen = sizeof columns - 1;
+    columns_reals( columns, &remLen );
+    if ( 0 != strcmp( chained, columns ) ) {
+        fputs( "Different output of real numbers.\n", stderr );
+        return EXIT_FAILURE;
+    }
+    bench( "chained", chained_reals, chained, sizeof chained, loops );
+    bench( "columns", columns_reals, columns, sizeof columns, loops );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "json-maker/json-maker.h"
+#include "json-maker/json-pack.h"
+
+/* Compare a compiled pack format with the equivalent chained calls. */
+
+struct weather {
+    int temp;
+    int hum;
+};
+
+struct time {
+    int hour;
+    int minute;
+};
+
+struct measure {
+    struct weather weather;
+    struct time time;
+};
+
+/** Convert a measure structure in a JSON string with chained calls.
+  * {"weather":{"temp":-5,"hum":48},"time":{"hour":18,"minute":32}}
+  * @param dest Destination memory block.
+  * @param measure Source structure.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int chained_to_json( char* dest, struct measure const* measure, size_t* remLen ) {
+    char* p = json_objOpen( dest, NULL, remLen );
+    p = json_objOpen( p, "weather", remLen );
+    p = json_int( p, "temp", measure->weather.temp, remLen );
+    p = json_int( p, "hum", measure->weather.hum, remLen );
+    p = json_objClose( p, remLen );
+    p = json_objOpen( p, "time", remLen );
+    p = json_int( p, "hour", measure->time.hour, remLen );
+    p = json_int( p, "minute", measure->time.minute, remLen );
+    p = json_objClose( p, remLen );
+    p = json_objClose( p, remLen );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Compiled format of a measure structure. */
+static unsigned char prog[ 128 ];
+
+/** Convert a measure structure in a JSON string with a compiled format.
+  * @param dest Destination memory block.
+  * @param measure Source structure.
+  * @param remLen Pointer to remaining length of dest
+  * @return The length of the null-terminated string in dest. */
+static int packed_to_json( char* dest, struct measure const* measure, size_t* remLen ) {
+    char* p = json_pack( dest, NULL, prog, remLen,
+                         measure->weather.temp, measure->weather.hum,
+                         measure->time.hour, measure->time.minute );
+    p = json_end( p, remLen );
+    return p - dest;
+}
+
+/** Get a monotonic time in nanoseconds. */
+static double now( void ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/** Build many documents and print the time per document. */
+static void bench( char const* title, int(*func)( char*, struct measure const*, size_t* ), long loops ) {
+    char buff[128];
+    long bytes = 0;
+    double const start = now();
+    for( long i = 0; i < loops; ++i ) {
+        struct measure const measure = {
+            .weather = { .temp = (int)( i % 60 ) - 20, .hum = (int)( i % 100 ) },
+            .time    = { .hour = (int)( i % 24 ), .minute = (int)( i % 60 ) }
+        };
+        size_t remLen = sizeof buff - 1;
+        bytes += func( buff, &measure, &remLen );
+    }
+    double const elapsed = now() - start;
+    printf( "%-8s %ld docs, %ld bytes, %.1f ns/doc\n", title, loops, bytes, elapsed / loops );
+}
+
+int main( int argc, char** argv ) {
+    long const loops = argc > 1 ? atol( argv[1] ) : 5000000;
+    if ( 0 == json_packCompile( prog, sizeof prog, "{weather:{temp:i,hum:i},time:{hour:i,minute:i}}" ) ) {
+        fputs( "Error compiling the format.\n", stderr );
+        return EXIT_FAILURE;
+    }
+    static struct measure const measure = { { -5, 48 }, { 18, 32 } };
+    char chained[128], packed[128];
+    size_t remLen = sizeof chained - 1;
+    chained_to_json( chained, &measure, &remLen );
+    remLen = sizeof packed - 1;
+    packed_to_json( packed, &measure, &remLen );
+    if ( 0 != strcmp( chained, packed ) ) {
+        fprintf( stderr, "Different output:\n%s\n%s\n", chained, packed );
+        return EXIT_FAILURE;
+    }
+    bench( "chained", chained_to_json, loops );
+    bench( "packed", packed_to_json, loops );
+    return EXIT_SUCCESS;
+}
@@ -51,55 +51,56 @@ struct data {
 
 /* Add a time object property in a JSON string.
   "name":{"temp":-5,"hum":48}, */
-char* json_weather( char* dest, char const* name, struct weather const* weather ) {
-    dest = json_objOpen( dest, name );              // --> "name":{\0
-    dest = json_int( dest, "temp", weather->temp ); // --> "name":{"temp":22,\0
-    dest = json_int( dest, "hum", weather->hum );   // --> "name":{"temp":22,"hum":45,\0
-    dest = json_objClose( dest );                   // --> "name":{"temp":22,"hum":45},\0
+char* json_weather( char* dest, char const* name, struct weather const* weather, size_t* remLen ) {
+    dest = json_objOpen( dest, name, remLen );              // --> "name":{\0
+    dest = json_int( dest, "temp", weather->temp, remLen ); // --> "name":{"temp":22,\0
+    dest = json_int( dest, "hum", weather->hum, remLen );   // --> "name":{"temp":22,"hum":45,\0
+    dest = json_objClose( dest, remLen );                   // --> "name":{"temp":22,"hum":45},\0
     return dest;
 }
 
 /* Add a time object property in a JSON string.
   "name":{"hour":18,"minute":32}, */
-char* json_time( char* dest, char const* name, struct time const* time ) {
-    dest = json_objOpen( dest, name );
-    dest = json_int( dest, "hour",   time->hour   );
-    dest = json_int( dest, "minute", time->minute );
-    dest = json_objClose( dest );
+char* json_time( char* dest, char const* name, struct time const* time, size_t* remLen ) {
+    dest = json_objOpen( dest, name, remLen );
+    dest = json_int( dest, "hour",   time->hour,   remLen );
+    dest = json_int( dest, "minute", time->minute, remLen );
+    dest = json_objClose( dest, remLen );
     return dest;
 }
 
 /* Add a measure object property in a JSON string.
  "name":{"weather":{"temp":-5,"hum":48},"time":{"hour":18,"minute":32}}, */
-char* json_measure( char* dest, char const* name, struct measure const* measure ) {
-    dest = json_objOpen( dest, name );
-    dest = json_weather( dest, "weather", &measure->weather );
-    dest = json_time( dest, "time", &measure->time );
-    dest = json_objClose( dest );
+char* json_measure( char* dest, char const* name, struct measure const* measure, size_t* remLen ) {
+    dest = json_objOpen( dest, name, remLen );
+    dest = json_weather( dest, "weather", &measure->weather, remLen );
+    dest = json_time( dest, "time", &measure->time, remLen );
+    dest = json_objClose( dest, remLen );
     return dest;
 }
 
 /* Add a data object property in a JSON string. */
-char* json_data( char* dest, char const* name, struct data const* data ) {
-    dest = json_objOpen( dest, NULL );
-    dest = json_str( dest, "city",   data->city );
-    dest = json_str( dest, "street", data->street );
-    dest = json_measure( dest, "measure", &data->measure );
-    dest = json_arrOpen( dest, "samples" );
+char* json_data( char* dest, char const* name, struct data const* data, size_t* remLen ) {
+    dest = json_objOpen( dest, NULL, remLen );
+    dest = json_str( dest, "city",   data->city, remLen );
+    dest = json_str( dest, "street", data->street, remLen );
+    dest = json_measure( dest, "measure", &data->measure, remLen );
+    dest = json_arrOpen( dest, "samples", remLen );
     for( int i = 0; i < 4; ++i )
-        dest = json_int( dest, NULL, data->samples[i] );
-    dest = json_arrClose( dest );
-    dest = json_objClose( dest );
+        dest = json_int( dest, NULL, data->samples[i], remLen );
+    dest = json_arrClose( dest, remLen );
+    dest = json_objClose( dest, remLen );
     return dest;
 }
 
 /** Convert a data structure to a root JSON object.
   * @param dest Destination memory block.
   * @param data Source data structure.
+  * @param remLen Pointer to remaining length of dest
   * @return  The JSON string length. */
-int data_to_json( char* dest, struct data const* data ) {
-    char* p = json_data( dest, NULL, data );
-    p = json_end( p );
+int data_to_json( char* dest, struct data const* data, size_t* remLen ) {
+    char* p = json_data( dest, NULL, data, remLen );
+    p = json_end( p, remLen );
     return p - dest;
 }
 
@@ -149,8 +150,9 @@ int main(int argc, char** argv) {
         }
     };
     char buff[512];
-    int len = data_to_json( buff, &data );
-    if( len >= sizeof buff ) {
+    size_t remLen = sizeof buff - 1;
+    int len = data_to_json( buff, &data, &remLen );
+    if( 0 == remLen ) {
         fprintf( stderr, "%s%d%s%d\n", "Error. Len: ", len, " Max: ", (int)sizeof buff - 1 );
         return EXIT_FAILURE;
     }
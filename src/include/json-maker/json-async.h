@@ -0,0 +1,121 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+#include <pthread.h>
+#ifdef JSON_MAKER_URING
+#include <liburing.h>
+#endif
+
+#ifndef JSON_ASYNC_H
+#define	JSON_ASYNC_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsonasync Asynchronous sink.
+  * JSON text is built in a ring of staging buffers. While some buffers are
+  * being written to a file or a socket the json_* functions fill the next
+  * one, so serialization and I/O overlap. It uses io_uring if the library
+  * is built with liburing (JSON_MAKER_URING) and the kernel allows it, or a
+  * writer thread otherwise.
+  * @{ */
+
+/** Max number of staging buffers. */
+enum { json_asyncMaxBuffers = 8 };
+
+/** State of a staging buffer. */
+struct jsonAsyncSlot {
+    size_t len;
+    size_t done;
+    long long offset;
+    int busy;
+};
+
+/** Asynchronous sink on a file descriptor. */
+struct jsonAsync {
+    int fd;
+    char* mem;
+    size_t size;
+    unsigned qty;
+    unsigned cur;
+    long long offset;
+    int error;
+    struct jsonAsyncSlot slot[ json_asyncMaxBuffers ];
+    int uring; /**< Non zero if io_uring is used. Zero for the writer thread. */
+#ifdef JSON_MAKER_URING
+    struct io_uring ring;
+    unsigned inflight;
+#endif
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned head;
+    unsigned queued;
+    int stop;
+    int failed;
+};
+
+/** Open an asynchronous sink.
+  * @param async Sink to be opened.
+  * @param fd Opened file or socket. Regular files are written from their
+  *           current position. The descriptor is not closed with the sink.
+  *           It must be in blocking mode: the writes wait until the data
+  *           is sent, so descriptors with O_NONBLOCK are rejected.
+  * @param mem Memory for the staging buffers. Its size is qty * size bytes.
+  * @param size Size of each staging buffer in bytes. It must hold the largest
+  *             element written between two calls to json_asyncSync() and a
+  *             spare character. At least 3 bytes.
+  * @param qty Number of staging buffers, from 2 to json_asyncMaxBuffers.
+  * @param remLen Pointer to remaining length of the staging buffer.
+  * @return Pointer to the start of JSON under construction or null if error. */
+char* json_asyncOpen( struct jsonAsync* async, int fd, char* mem, size_t size, unsigned qty, size_t* remLen );
+
+/** Send the text finished so far if the staging buffer is half full and go
+  * on in the next one. It only waits if all the buffers are in flight.
+  * Call it between elements, i.e. after a json_* function. If a write has
+  * failed the remaining length is set to zero so the caller can stop.
+  * @param async Opened sink.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of the staging buffer.
+  * @return Pointer to the new end of JSON under construction. */
+char* json_asyncSync( struct jsonAsync* async, char* dest, size_t* remLen );
+
+/** Send the rest of the text, wait for all the writes and release the sink.
+  * Call it after json_end().
+  * @param async Opened sink.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of the staging buffer.
+  * @return Zero on success. Non zero if a buffer overflowed or a write failed. */
+int json_asyncClose( struct jsonAsync* async, char* dest, size_t* remLen );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_ASYNC_H */
@@ -0,0 +1,95 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef JSON_CACHE_H
+#define	JSON_CACHE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsoncache Subtree cache.
+  * A value that rarely changes is serialized once by a callback and its
+  * bytes are copied in the next documents while its version is the same.
+  * The memory of the cache is split in two slots. A new version is built
+  * in the document and copied in the slot that is not in use, then it is
+  * published by swapping a pointer. Many threads can read the cache while
+  * one refreshes it and readers never wait. If the slot is still in use by
+  * readers of an old version the new one is cached by a later call.
+  * @{ */
+
+/** Slot of a cache. It is private. */
+struct jsonCacheSlot {
+    char* buff;
+    size_t len;
+    uint64_t version;
+    unsigned readers;
+};
+
+/** Cache of a serialized value. */
+struct jsonCache {
+    struct jsonCacheSlot slot[2];
+    struct jsonCacheSlot* active;
+    size_t size;
+    int busy;
+    /** Builds the value in dest. It is called with a null name and the
+      * context given in json_cacheInit(), like the other json_* calls. */
+    char* (*build)( char* dest, char const* name, void* ctx, size_t* remLen );
+    void* ctx;
+};
+
+/** Initialize a cache.
+  * @param cache Cache to be initialized.
+  * @param mem Memory block for the two slots. It must remain valid until
+  *            the cache is no longer used.
+  * @param size Size of mem in bytes. Each slot takes half of it. Values that
+  *             do not fit in a slot are not cached.
+  * @param build Callback that builds the value.
+  * @param ctx Context passed to the callback.
+  * @return Zero on success. Non zero if the memory block is too small. */
+int json_cacheInit( struct jsonCache* cache, char* mem, size_t size,
+                    char* (*build)( char* dest, char const* name, void* ctx, size_t* remLen ), void* ctx );
+
+/** Add the cached value as a property in a JSON string. The callback is
+  * called only if the version differs from the cached one.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param cache Initialized cache.
+  * @param version Version of the value, e.g. a generation number that is
+  *                incremented when the source data changes.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+char* json_cache( char* dest, char const* name, struct jsonCache* cache, uint64_t version, size_t* remLen );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_CACHE_H */
@@ -0,0 +1,299 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/* Definitions of the JSON Maker functions that write CBOR (RFC 8949)
+   instead of JSON text. It is included by json-maker-impl.h when
+   JSON_MAKER_CBOR is defined, so the same sequence of calls builds a binary
+   document. Objects and arrays are written with indefinite length because
+   the calls do not know the number of items when they are opened. */
+
+#ifndef JSON_CBOR_IMPL_H
+#define	JSON_CBOR_IMPL_H
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+/** Major types of the CBOR data items. */
+enum {
+    cbor_uint  = 0,
+    cbor_nint  = 1,
+    cbor_text  = 3,
+    cbor_tag   = 6,
+};
+
+/** Copy a data item at the end of a CBOR document. The item is copied
+  * whole or not at all. If it does not fit the remaining length is zero.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param data Bytes of the item.
+  * @param len Number of bytes.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* cborput( char* dest, void const* data, size_t len, size_t* remLen ) {
+    if ( len > *remLen ) {
+        *remLen = 0;
+        *dest = '\0';
+        return dest;
+    }
+    unsigned char const* src = data;
+    for( size_t i = 0; i < len; ++i )
+        dest[i] = (char)src[i];
+    *remLen -= len;
+    dest += len;
+    *dest = '\0';
+    return dest;
+}
+
+/** Encode the head of a data item: its major type and argument.
+  * @param buff Destination with room for nine bytes.
+  * @param major Major type.
+  * @param value Argument. The value, length or tag number.
+  * @return Number of bytes of the head. */
+static size_t cborarg( unsigned char* buff, int major, uint64_t value ) {
+    if ( value < 24 ) {
+        buff[0] = (unsigned char)( major << 5 | value );
+        return 1;
+    }
+    int const size = value <= 0xFFu ? 1 : value <= 0xFFFFu ? 2 : value <= 0xFFFFFFFFu ? 4 : 8;
+    buff[0] = (unsigned char)( major << 5 | ( 1 == size ? 24 : 2 == size ? 25 : 4 == size ? 26 : 27 ) );
+    for( int i = size; i > 0; --i, value >>= 8 )
+        buff[i] = (unsigned char)value;
+    return 1 + size;
+}
+
+/** Add the head of a data item.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param major Major type.
+  * @param value Argument. The value, length or tag number.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* cborhead( char* dest, int major, uint64_t value, size_t* remLen ) {
+    unsigned char buff[9];
+    return cborput( dest, buff, cborarg( buff, major, value ), remLen );
+}
+
+/** Add a text string. It is written whole or not at all.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param text Characters of the string. They are copied without escapes.
+  * @param len Number of characters.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* cbortext( char* dest, char const* text, size_t len, size_t* remLen ) {
+    unsigned char buff[9];
+    size_t const size = cborarg( buff, cbor_text, len );
+    if ( size + len > *remLen ) {
+        *remLen = 0;
+        *dest = '\0';
+        return dest;
+    }
+    dest = cborput( dest, buff, size, remLen );
+    return cborput( dest, text, len, remLen );
+}
+
+/** Add the key of a property.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* cborkey( char* dest, char const* name, size_t* remLen ) {
+    return NULL == name ? dest : cbortext( dest, name, strlen( name ), remLen );
+}
+
+/** Add a signed integer property.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param value Value of the property.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* cborint( char* dest, char const* name, long long value, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    if ( 0 > value )
+        return cborhead( dest, cbor_nint, (uint64_t)( -1 - value ), remLen );
+    return cborhead( dest, cbor_uint, (uint64_t)value, remLen );
+}
+
+/** Add an unsigned integer property.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param value Value of the property.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* cboruint( char* dest, char const* name, unsigned long long value, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    return cborhead( dest, cbor_uint, value, remLen );
+}
+
+/** Convert a single precision value to half precision if it is exact.
+  * @param value Single precision value.
+  * @param half Destination of the bits of the half precision value.
+  * @return Non zero if the conversion is exact. */
+static int cborhalf( float value, uint16_t* half ) {
+    uint32_t bits;
+    memcpy( &bits, &value, sizeof bits );
+    uint16_t const sign = (uint16_t)( bits >> 16 & 0x8000u );
+    int const exp = (int)( bits >> 23 & 0xFFu ) - 127;
+    uint32_t const mant = bits & 0x7FFFFFu;
+    if ( -127 == exp && 0 == mant ) {
+        *half = sign;
+        return 1;
+    }
+    if ( 128 == exp ) {
+        *half = sign | ( 0 != mant ? 0x7E00u : 0x7C00u );
+        return 1;
+    }
+    if ( 15 < exp || -24 > exp )
+        return 0;
+    if ( -14 <= exp ) {
+        if ( 0 != ( mant & 0x1FFFu ) )
+            return 0;
+        *half = sign | (uint16_t)( ( exp + 15 ) << 10 ) | (uint16_t)( mant >> 13 );
+        return 1;
+    }
+    // Subnormal in half precision.
+    uint32_t const full = mant | 0x800000u;
+    int const shift = -exp - 1;
+    if ( 0 != ( full & ( ( 1u << shift ) - 1 ) ) )
+        return 0;
+    *half = sign | (uint16_t)( full >> shift );
+    return 1;
+}
+
+/* Open a map in a CBOR document. */
+JSON_MAKER_API char* json_objOpen( char* dest, char const* name, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    return cborput( dest, "\xBF", 1, remLen );
+}
+
+/* Close a map in a CBOR document. */
+JSON_MAKER_API char* json_objClose( char* dest, size_t* remLen ) {
+    return cborput( dest, "\xFF", 1, remLen );
+}
+
+/* Open an array in a CBOR document. */
+JSON_MAKER_API char* json_arrOpen( char* dest, char const* name, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    return cborput( dest, "\x9F", 1, remLen );
+}
+
+/* Close an array in a CBOR document. */
+JSON_MAKER_API char* json_arrClose( char* dest, size_t* remLen ) {
+    return cborput( dest, "\xFF", 1, remLen );
+}
+
+/* Used to finish the root item. CBOR has no separators to remove. */
+JSON_MAKER_API char* json_end( char* dest, size_t* remLen ) {
+    (void)remLen;
+    return dest;
+}
+
+/* Add a text string property in a CBOR document. */
+JSON_MAKER_API char* json_nstr( char* dest, char const* name, char const* value, int len, size_t* remLen ) {
+    size_t size = 0;
+    while( ( 0 > len || (int)size < len ) && '\0' != value[ size ] )
+        ++size;
+    dest = cborkey( dest, name, remLen );
+    return cbortext( dest, value, size, remLen );
+}
+
+/* Add a boolean property in a CBOR document. */
+JSON_MAKER_API char* json_bool( char* dest, char const* name, int value, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    return cborput( dest, value ? "\xF5" : "\xF4", 1, remLen );
+}
+
+/* Add a null property in a CBOR document. */
+JSON_MAKER_API char* json_null( char* dest, char const* name, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    return cborput( dest, "\xF6", 1, remLen );
+}
+
+/* Add an integer property in a CBOR document. */
+JSON_MAKER_API char* json_int( char* dest, char const* name, int value, size_t* remLen ) {
+    return cborint( dest, name, value, remLen );
+}
+
+/* Add an unsigned integer property in a CBOR document. */
+JSON_MAKER_API char* json_uint( char* dest, char const* name, unsigned int value, size_t* remLen ) {
+    return cboruint( dest, name, value, remLen );
+}
+
+/* Add a long integer property in a CBOR document. */
+JSON_MAKER_API char* json_long( char* dest, char const* name, long int value, size_t* remLen ) {
+    return cborint( dest, name, value, remLen );
+}
+
+/* Add an unsigned long integer property in a CBOR document. */
+JSON_MAKER_API char* json_ulong( char* dest, char const* name, unsigned long int value, size_t* remLen ) {
+    return cboruint( dest, name, value, remLen );
+}
+
+/* Add a long long integer property in a CBOR document. */
+JSON_MAKER_API char* json_verylong( char* dest, char const* name, long long int value, size_t* remLen ) {
+    return cborint( dest, name, value, remLen );
+}
+
+/* Add a floating point property in a CBOR document. It takes the shortest
+   of half, single and double precision that keeps the exact value. */
+JSON_MAKER_API char* json_double( char* dest, char const* name, double value, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    unsigned char buff[9];
+    if ( isnan( value ) || isinf( value ) || ( -FLT_MAX <= value && value <= FLT_MAX && (float)value == value ) ) {
+        float const single = (float)value;
+        uint16_t half;
+        if ( cborhalf( single, &half ) ) {
+            buff[0] = 0xF9;
+            buff[1] = (unsigned char)( half >> 8 );
+            buff[2] = (unsigned char)half;
+            return cborput( dest, buff, 3, remLen );
+        }
+        uint32_t bits;
+        memcpy( &bits, &single, sizeof bits );
+        buff[0] = 0xFA;
+        for( int i = 4; i > 0; --i, bits >>= 8 )
+            buff[i] = (unsigned char)bits;
+        return cborput( dest, buff, 5, remLen );
+    }
+    uint64_t bits;
+    memcpy( &bits, &value, sizeof bits );
+    buff[0] = 0xFB;
+    for( int i = 8; i > 0; --i, bits >>= 8 )
+        buff[i] = (unsigned char)bits;
+    return cborput( dest, buff, 9, remLen );
+}
+
+/** Add a timestamp property as a standard date/time string, tag 0.
+  * @param dest Pointer to the end of CBOR under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param text Null-terminated RFC 3339 text of the timestamp.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of CBOR under construction. */
+static char* stamp( char* dest, char const* name, char const* text, size_t* remLen ) {
+    dest = cborkey( dest, name, remLen );
+    dest = cborhead( dest, cbor_tag, 0, remLen );
+    return cbortext( dest, text, strlen( text ), remLen );
+}
+
+#endif	/* JSON_CBOR_IMPL_H */
@@ -0,0 +1,74 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+
+#ifndef JSON_COLUMN_H
+#define	JSON_COLUMN_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsoncolumn Columnar data.
+  * Data stored as a structure of arrays is written as an array of objects,
+  * one object per row and one property per column, in a single call.
+  * The keys are quoted once and the numbers are formatted column by column
+  * in tiles of rows that fit in the cache.
+  *
+  * Types of the columns, the same letters of the pack formats:
+  * i int, u unsigned int, l long, L unsigned long, I long long, d double,
+  * b boolean as int, s null-terminated string or null. Other letters are
+  * written as null.
+  * @{ */
+
+/** Description of a column. */
+struct jsonColumn {
+    char const* name;   /**< Key of the property. It is copied without escapes.
+                             It cannot be null. */
+    char type;          /**< Type of the values. */
+    void const* data;   /**< Pointer to the value of the first row. */
+    size_t stride;      /**< Bytes between the values of two rows. Zero if
+                             the values are contiguous. */
+};
+
+/** Add an array of objects made from columns in a JSON string.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param cols Description of the columns in the order of the properties.
+  * @param qty Number of columns.
+  * @param rows Number of rows.
+  * @param remLen Pointer to remaining length of dest. It is set to zero if
+  *               a column has no name.
+  * @return Pointer to the new end of JSON under construction. */
+char* json_columns( char* dest, char const* name, struct jsonColumn const* cols, int qty, size_t rows, size_t* remLen );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_COLUMN_H */
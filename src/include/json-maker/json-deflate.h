@@ -0,0 +1,66 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+#include <zlib.h>
+#include "json-maker/json-stream.h"
+
+#ifndef JSON_DEFLATE_H
+#define	JSON_DEFLATE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsondeflate Deflate filter.
+  * Output filter that compresses the JSON text with zlib as it is produced.
+  * @{ */
+
+/** Filter that compresses its input and passes the result to the next one. */
+struct jsonDeflate {
+    struct jsonFilter filter;
+    z_stream strm;
+    unsigned char* buff;
+    size_t size;
+};
+
+/** Initialize a deflate filter.
+  * @param df Filter to be initialized.
+  * @param level Compression level from 0 to 9 or Z_DEFAULT_COMPRESSION.
+  * @param gzip Non zero for gzip format. Zero for zlib format.
+  * @param buff Memory for the compressed data passed to the next filter.
+  * @param size Size of buff in bytes. From 1 to 1 GB.
+  * @param next Next filter of the chain.
+  * @return Pointer to the filter interface or null if an argument is not
+  *         valid or zlib fails. */
+struct jsonFilter* json_deflateInit( struct jsonDeflate* df, int level, int gzip, unsigned char* buff, size_t size, struct jsonFilter* next );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_DEFLATE_H */
@@ -0,0 +1,527 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/* Definitions of the JSON Maker functions. They are compiled in json-maker.c
+   or, if JSON_MAKER_INLINE is defined, included by json-maker.h as static
+   inline functions so they can be inlined into the caller code. If
+   JSON_MAKER_CBOR is defined the functions of json-cbor-impl.h are used
+   instead of the ones that write JSON text. */
+
+#ifndef JSON_MAKER_IMPL_H
+#define	JSON_MAKER_IMPL_H
+
+#include <stddef.h> // For NULL
+#include "json-maker/json-maker.h"
+
+/* In a single header build the private functions are renamed to keep them
+   away from the names of the user code. */
+#ifdef JSON_MAKER_INLINE
+#define chtoa         json_maker_chtoa
+#define atoa          json_maker_atoa
+#define strname       json_maker_strname
+#define nibbletoch    json_maker_nibbletoch
+#define escape        json_maker_escape
+#define atoesc        json_maker_atoesc
+#define esctoa        json_maker_esctoa
+#define primitivename json_maker_primitivename
+#define inttoa        json_maker_inttoa
+#define longtoa       json_maker_longtoa
+#define uinttoa       json_maker_uinttoa
+#define ulongtoa      json_maker_ulongtoa
+#define verylongtoa   json_maker_verylongtoa
+#define realtoa       json_maker_realtoa
+#define twodigits     json_maker_twodigits
+#define daytodate     json_maker_daytodate
+#define stamp         json_maker_stamp
+#define cborput       json_maker_cborput
+#define cborarg       json_maker_cborarg
+#define cborhead      json_maker_cborhead
+#define cbortext      json_maker_cbortext
+#define cborkey       json_maker_cborkey
+#define cborint       json_maker_cborint
+#define cboruint      json_maker_cboruint
+#define cborhalf      json_maker_cborhalf
+#endif
+
+#ifdef JSON_MAKER_CBOR
+#include "json-maker/json-cbor-impl.h"
+#else
+
+/** Add a character at the end of a string.
+  * @param dest Pointer to the null character of the string
+  * @param ch Value to be added.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the null character of the destination string. */
+static char* chtoa( char* dest, char ch, size_t* remLen ) {
+    if (*remLen != 0) {
+        --*remLen;
+        *dest   = ch;
+        *++dest = '\0';
+    }
+    return dest;
+}
+
+/** Copy a null-terminated string.
+  * @param dest Destination memory block.
+  * @param src Source string.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the null character of the destination string. */
+static char* atoa( char* dest, char const* src, size_t* remLen  ) {
+    for( ; *src != '\0' && *remLen != 0; ++dest, ++src, --*remLen )
+        *dest = *src;
+    *dest = '\0';
+    return dest;
+}
+
+/* Open a JSON object in a JSON string. */
+JSON_MAKER_API char* json_objOpen( char* dest, char const* name, size_t* remLen  ) {
+    if ( NULL == name )
+        dest = chtoa( dest, '{', remLen );
+    else {
+        dest = chtoa( dest, '\"', remLen );
+        dest = atoa( dest, name, remLen );
+        dest = atoa( dest, "\":{", remLen );
+    }
+    return dest;
+}
+
+/* Close a JSON object in a JSON string. */
+JSON_MAKER_API char* json_objClose( char* dest, size_t* remLen  ) {
+    if ( dest[-1] == ',' )
+    {
+        --dest;
+        ++*remLen;
+    }
+    return atoa( dest, "},", remLen );
+}
+
+/* Open an array in a JSON string. */
+JSON_MAKER_API char* json_arrOpen( char* dest, char const* name, size_t* remLen  ) {
+    if ( NULL == name )
+        dest = chtoa( dest, '[', remLen );
+    else {
+        dest = chtoa( dest, '\"', remLen );
+        dest = atoa( dest, name, remLen );
+        dest = atoa( dest, "\":[", remLen );
+    }
+    return dest;
+}
+
+/* Close an array in a JSON string. */
+JSON_MAKER_API char* json_arrClose( char* dest, size_t* remLen  ) {
+    if ( dest[-1] == ',')
+    {
+        --dest;
+        ++*remLen;
+    }
+    return atoa( dest, "],", remLen );
+}
+
+/** Add the name of a text property.
+  * @param dest Destination memory.
+  * @param name The name of the property.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the next char. */
+static char* strname( char* dest, char const* name, size_t* remLen  ) {
+    dest = chtoa( dest, '\"', remLen );
+    if ( NULL != name ) {
+        dest = atoa( dest, name, remLen );
+        dest = atoa( dest, "\":\"", remLen );
+    }
+    return dest;
+}
+
+/** Get the hexadecimal digit of the least significant nibble of a integer. */
+static int nibbletoch( int nibble ) {
+    return "0123456789ABCDEF"[ nibble % 16u ];
+}
+
+/** Get the escape character of a non-printable.
+  * @param ch Character source.
+  * @return The escape character or null character if error. */
+static int escape( int ch ) {
+    int i;
+    static struct { char code; char ch; } const pair[] = {
+        { '\"', '\"' }, { '\\', '\\' }, { '/',  '/'  }, { 'b',  '\b' },
+        { 'f',  '\f' }, { 'n',  '\n' }, { 'r',  '\r' }, { 't',  '\t' },
+    };
+    for( i = 0; i < sizeof pair / sizeof *pair; ++i )
+        if ( ch == pair[i].ch )
+            return pair[i].code;
+    return '\0';
+}
+
+/** Get the text of a character in a JSON string.
+  * @param dest Destination with room for six characters.
+  * @param ch Character source.
+  * @return Number of characters of the text, from 1 to 6. */
+static int esctoa( char* dest, int ch ) {
+    if ( (unsigned char)ch >= ' ' && ch != '\"' && ch != '\\' && ch != '/' ) {
+        dest[0] = (char)ch;
+        return 1;
+    }
+    dest[0] = '\\';
+    int const esc = escape( ch );
+    if ( esc ) {
+        dest[1] = (char)esc;
+        return 2;
+    }
+    dest[1] = 'u';
+    dest[2] = '0';
+    dest[3] = '0';
+    dest[4] = (char)nibbletoch( ch / 16 );
+    dest[5] = (char)nibbletoch( ch );
+    return 6;
+}
+
+/** Copy a null-terminated string inserting escape characters if needed.
+  * @param dest Destination memory block.
+  * @param src Source string.
+  * @param len Max length of source. < 0 for unlimit.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the null character of the destination string. */
+static char* atoesc( char* dest, char const* src, int len, size_t* remLen  ) {
+    for( int i = 0; src[i] != '\0' && ( i < len || 0 > len ) && *remLen != 0; ++i ) {
+        char buff[6];
+        int const n = esctoa( buff, src[i] );
+        for( int j = 0; j < n && *remLen != 0; ++j, --*remLen )
+            *dest++ = buff[j];
+    }
+    *dest = '\0';
+    return dest;
+}
+
+/* Add the escaped characters of a string without quotes in a JSON string. */
+JSON_MAKER_API char* json_escape( char* dest, char const* value, int len, int* used, size_t* remLen ) {
+    int i;
+    for( i = 0; value[i] != '\0' && ( i < len || 0 > len ); ++i ) {
+        char buff[6];
+        int const n = esctoa( buff, value[i] );
+        if ( (size_t)n > *remLen )
+            break;
+        for( int j = 0; j < n; ++j )
+            dest[j] = buff[j];
+        dest += n;
+        *remLen -= (size_t)n;
+    }
+    *dest = '\0';
+    *used = i;
+    return dest;
+}
+
+/* Add a text property in a JSON string. */
+JSON_MAKER_API char* json_nstr( char* dest, char const* name, char const* value, int len, size_t* remLen  ) {
+    dest = strname( dest, name, remLen );
+    dest = atoesc( dest, value, len, remLen );
+    dest = atoa( dest, "\",", remLen );
+    return dest;
+}
+
+/** Add the name of a primitive property.
+  * @param dest Destination memory.
+  * @param name The name of the property.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the next char. */
+static char* primitivename( char* dest, char const* name, size_t* remLen  ) {
+    if( NULL == name )
+        return dest;
+    dest = chtoa( dest, '\"', remLen );
+    dest = atoa( dest, name, remLen );
+    dest = atoa( dest, "\":", remLen );
+    return dest;
+}
+
+/*  Add a boolean property in a JSON string. */
+JSON_MAKER_API char* json_bool( char* dest, char const* name, int value, size_t* remLen  ) {
+    dest = primitivename( dest, name, remLen );
+    dest = atoa( dest, value ? "true," : "false,", remLen );
+    return dest;
+}
+
+/* Add a null property in a JSON string. */
+JSON_MAKER_API char* json_null( char* dest, char const* name, size_t* remLen  ) {
+    dest = primitivename( dest, name, remLen );
+    dest = atoa( dest, "null,", remLen );
+    return dest;
+}
+
+/* Used to finish the root JSON object. After call json_objClose(). */
+JSON_MAKER_API char* json_end( char* dest, size_t* remLen ) {
+    if ( ',' == dest[-1] ) {
+        dest[-1] = '\0';
+        --dest;
+        ++*remLen;
+    }
+    return dest;
+}
+
+/** Add a timestamp property.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param text Null-terminated RFC 3339 text of the timestamp.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* stamp( char* dest, char const* name, char const* text, size_t* remLen ) {
+    // The characters of a timestamp never need escapes.
+    dest = strname( dest, name, remLen );
+    dest = atoa( dest, text, remLen );
+    dest = atoa( dest, "\",", remLen );
+    return dest;
+}
+
+#endif /* JSON_MAKER_CBOR */
+
+/** Write two decimal digits.
+  * @param dest Destination memory with room for two characters.
+  * @param val Value from 0 to 99.
+  * @return Pointer to the next char. */
+static char* twodigits( char* dest, unsigned val ) {
+    static char const lut[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    dest[0] = lut[ 2 * val ];
+    dest[1] = lut[ 2 * val + 1 ];
+    return dest + 2;
+}
+
+/** Convert a number of days since 1970-01-01 to a civil date.
+  * Consecutive calls usually fall on the same day so the last date is
+  * cached. The cache is a single 64-bit word so it needs no lock. It is
+  * left out where 64-bit atomics are not lock free, e.g. 32-bit MCUs.
+  * @param days Days since 1970-01-01.
+  * @param year Destination of the year.
+  * @param month Destination of the month, from 1 to 12.
+  * @param day Destination of the day of month, from 1 to 31. */
+static void daytodate( int64_t days, unsigned* year, unsigned* month, unsigned* day ) {
+#if defined __GNUC__ && 2 == __GCC_ATOMIC_LLONG_LOCK_FREE
+    // Days in the high half and yyyy:mm:dd in the low one. Zero is empty.
+    static uint64_t cache = 0;
+    uint64_t const cached = __atomic_load_n( &cache, __ATOMIC_RELAXED );
+    if ( 0 != cached && (uint32_t)( cached >> 32 ) == (uint32_t)days ) {
+        *year  = ( cached >> 16 ) & 0xFFFFu;
+        *month = ( cached >> 8 ) & 0xFFu;
+        *day   = cached & 0xFFu;
+        return;
+    }
+#endif
+    // Proleptic Gregorian calendar in eras of 400 years from 0000-03-01.
+    int64_t const z = days + 719468;
+    int64_t const era = ( 0 <= z ? z : z - 146096 ) / 146097;
+    unsigned const doe = (unsigned)( z - era * 146097 );
+    unsigned const yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+    unsigned const doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+    unsigned const mp = ( 5 * doy + 2 ) / 153;
+    *day   = doy - ( 153 * mp + 2 ) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year  = (unsigned)( yoe + era * 400 + ( *month <= 2 ) );
+#if defined __GNUC__ && 2 == __GCC_ATOMIC_LLONG_LOCK_FREE
+    uint64_t const value = (uint64_t)(uint32_t)days << 32 | (uint64_t)( *year & 0xFFFFu ) << 16 | *month << 8 | *day;
+    __atomic_store_n( &cache, value, __ATOMIC_RELAXED );
+#endif
+}
+
+/* Add a RFC 3339 UTC timestamp property in a JSON string. */
+JSON_MAKER_API char* json_timestamp( char* dest, char const* name, int64_t epoch_ns, int precision, size_t* remLen ) {
+    enum { nsPerSec = 1000000000, secPerDay = 86400 };
+    int64_t secs = epoch_ns / nsPerSec;
+    int64_t ns = epoch_ns % nsPerSec;
+    if ( 0 > ns ) {
+        ns += nsPerSec;
+        --secs;
+    }
+    int64_t days = secs / secPerDay;
+    int64_t sod = secs % secPerDay;
+    if ( 0 > sod ) {
+        sod += secPerDay;
+        --days;
+    }
+    unsigned year, month, day;
+    daytodate( days, &year, &month, &day );
+    char buff[ sizeof "2026-10-18T12:34:56.123456789Z" ];
+    char* p = twodigits( buff, year / 100 % 100 );
+    p = twodigits( p, year % 100 );
+    *p++ = '-';
+    p = twodigits( p, month );
+    *p++ = '-';
+    p = twodigits( p, day );
+    *p++ = 'T';
+    p = twodigits( p, (unsigned)( sod / 3600 ) );
+    *p++ = ':';
+    p = twodigits( p, (unsigned)( sod / 60 % 60 ) );
+    *p++ = ':';
+    p = twodigits( p, (unsigned)( sod % 60 ) );
+    if ( 0 < precision ) {
+        if ( 9 < precision )
+            precision = 9;
+        *p++ = '.';
+        unsigned long frac = (unsigned long)ns;
+        for( int i = 9; i > precision; --i )
+            frac /= 10;
+        for( int i = precision - 1; i >= 0; --i ) {
+            p[i] = (char)( '0' + frac % 10 );
+            frac /= 10;
+        }
+        p += precision;
+    }
+    *p++ = 'Z';
+    *p = '\0';
+    return stamp( dest, name, buff, remLen );
+}
+
+#ifdef JSON_MAKER_CBOR
+
+/* The numbers are defined in json-cbor-impl.h. */
+
+#elif defined NO_SPRINTF
+
+#include "json-maker/json-num.h"
+
+/* Numbers are formatted without the C library. Each integer type uses the
+   division of its own width so 32-bit targets do not pull in the 64-bit
+   division unless json_verylong() is used. */
+
+#define numtoa( func, type, utype )                             \
+static char* func( char* dest, type val, size_t* remLen ) {    \
+    char buff[ 3 * sizeof( utype ) + 2 ];                       \
+    char* p = buff + sizeof buff;                               \
+    *--p = '\0';                                                \
+    utype num = 0 > val ? -(utype)val : (utype)val;             \
+    do {                                                        \
+        *--p = (char)( '0' + num % 10 );                        \
+        num /= 10;                                              \
+    } while( 0 != num );                                        \
+    if ( 0 > val )                                              \
+        *--p = '-';                                             \
+    return atoa( dest, p, remLen );                             \
+}
+
+#define json_num( func, func2, type )                                           \
+JSON_MAKER_API char* func( char* dest, char const* name, type value, size_t* remLen ) { \
+    dest = primitivename( dest, name, remLen );                                 \
+    dest = func2( dest, value, remLen );                                        \
+    dest = chtoa( dest, ',', remLen );                                          \
+    return dest;                                                                \
+}
+
+#define ALL_TYPES \
+    X( int,      int,          unsigned int        ) \
+    X( long,     long,         unsigned long       ) \
+    X( uint,     unsigned int, unsigned int        ) \
+    X( ulong,    unsigned      long, unsigned long ) \
+    X( verylong, long long,    unsigned long long  ) \
+
+#define X( name, type, utype ) numtoa( name##toa, type, utype )
+ALL_TYPES
+#undef X
+
+#define X( name, type, utype ) json_num( json_##name, name##toa, type )
+ALL_TYPES
+#undef X
+
+/** Format a real number like printf with "%g".
+  * @param dest Pointer to the end of JSON under construction.
+  * @param val Value to be formatted.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* realtoa( char* dest, double val, size_t* remLen ) {
+    char buff[ json_realMaxLen + 1 ];
+    buff[ json_gtoa( buff, val ) ] = '\0';
+    return atoa( dest, buff, remLen );
+}
+
+JSON_MAKER_API char* json_double( char* dest, char const* name, double value, size_t* remLen ) {
+    dest = primitivename( dest, name, remLen );
+    dest = realtoa( dest, value, remLen );
+    dest = chtoa( dest, ',', remLen );
+    return dest;
+}
+
+#else
+
+#include <stdio.h>
+
+#define ALL_TYPES \
+    X( json_int,      int,           "%d"   ) \
+    X( json_long,     long,          "%ld"  ) \
+    X( json_uint,     unsigned int,  "%u"   ) \
+    X( json_ulong,    unsigned long, "%lu"  ) \
+    X( json_verylong, long long,     "%lld" ) \
+    X( json_double,   double,        "%g"   ) \
+
+
+#define json_num( funcname, type, fmt )                         \
+JSON_MAKER_API char* funcname( char* dest, char const* name, type value, size_t* remLen  ) { \
+    int digitLen;                                                                   \
+    dest = primitivename( dest, name, remLen );                                     \
+    digitLen = snprintf( dest, *remLen, fmt, value );                               \
+    if(digitLen >= (int)*remLen+1){                                                 \
+    	digitLen = (int)*remLen;}                                                     \
+    *remLen -= (size_t)digitLen;                                                    \
+    dest += digitLen;                                                               \
+    dest = chtoa( dest, ',', remLen );                                              \
+    return dest;                                                                    \
+}
+
+#define X( name, type, fmt ) json_num( name, type, fmt )
+ALL_TYPES
+#undef X
+
+
+#endif
+
+#undef ALL_TYPES
+#undef json_num
+#undef numtoa
+
+#ifdef JSON_MAKER_INLINE
+#undef chtoa
+#undef atoa
+#undef strname
+#undef nibbletoch
+#undef escape
+#undef atoesc
+#undef esctoa
+#undef primitivename
+#undef inttoa
+#undef longtoa
+#undef uinttoa
+#undef ulongtoa
+#undef verylongtoa
+#undef realtoa
+#undef twodigits
+#undef daytodate
+#undef stamp
+#undef cborput
+#undef cborarg
+#undef cborhead
+#undef cbortext
+#undef cborkey
+#undef cborint
+#undef cboruint
+#undef cborhalf
+#endif
+
+#endif	/* JSON_MAKER_IMPL_H */
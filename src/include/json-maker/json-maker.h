@@ -24,6 +24,7 @@
 */
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifndef MAKE_JSON_H
 #define	MAKE_JSON_H
@@ -35,37 +36,48 @@ extern "C" {
 /** @defgroup makejoson Make JSON.
   * @{ */
 
+/* If JSON_MAKER_INLINE is defined the library is used as a single header.
+   The functions are defined here as static inline and the calls can be
+   inlined into the caller code. If JSON_MAKER_CBOR is defined the same
+   functions write CBOR (RFC 8949) instead of JSON text. Link with the
+   json_maker_cbor library or define both macros. */
+#ifdef JSON_MAKER_INLINE
+#define JSON_MAKER_API static inline
+#else
+#define JSON_MAKER_API
+#endif
+
 /** Open a JSON object in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param name Pointer to null-terminated string or null for unnamed.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_objOpen( char* dest, char const* name, size_t* remLen );
+JSON_MAKER_API char* json_objOpen( char* dest, char const* name, size_t* remLen );
 
 /** Close a JSON object in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_objClose( char* dest, size_t* remLen );
+JSON_MAKER_API char* json_objClose( char* dest, size_t* remLen );
 
 /** Used to finish the root JSON object. After call json_objClose().
   * @param dest Pointer to the end of JSON under construction.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_end( char* dest, size_t* remLen );
+JSON_MAKER_API char* json_end( char* dest, size_t* remLen );
 
 /** Open an array in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param name Pointer to null-terminated string or null for unnamed.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_arrOpen( char* dest, char const* name, size_t* remLen );
+JSON_MAKER_API char* json_arrOpen( char* dest, char const* name, size_t* remLen );
 
 /** Close an array in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_arrClose( char* dest, size_t* remLen );
+JSON_MAKER_API char* json_arrClose( char* dest, size_t* remLen );
 /** Add a text property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param name Pointer to null-terminated string or null for unnamed.
@@ -74,7 +86,7 @@ char* json_arrClose( char* dest, size_t* remLen );
   * @param len Max length of value. < 0 for unlimit.  
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */  
-char* json_nstr( char* dest, char const* name, char const* value, int len, size_t* remLen );
+JSON_MAKER_API char* json_nstr( char* dest, char const* name, char const* value, int len, size_t* remLen );
 
 /** Add a text property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -87,20 +99,33 @@ static inline char* json_str( char* dest, char const* name, char const* value, s
     return json_nstr( dest, name, value, -1, remLen );  
 }
 
+#ifndef JSON_MAKER_CBOR
+/** Add the escaped characters of a string without quotes in a JSON string.
+  * An escape sequence is never split: it stops before the first character
+  * whose text does not fit, so the rest can be added later.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param value A valid null-terminated string.
+  * @param len Max length of value. < 0 for unlimit.
+  * @param used Destination of the number of characters of value consumed.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+JSON_MAKER_API char* json_escape( char* dest, char const* value, int len, int* used, size_t* remLen );
+#endif
+
 /** Add a boolean property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param name Pointer to null-terminated string or null for unnamed.
   * @param value Zero for false. Non zero for true.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_bool( char* dest, char const* name, int value, size_t* remLen );
+JSON_MAKER_API char* json_bool( char* dest, char const* name, int value, size_t* remLen );
 
 /** Add a null property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
   * @param name Pointer to null-terminated string or null for unnamed.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_null( char* dest, char const* name, size_t* remLen );
+JSON_MAKER_API char* json_null( char* dest, char const* name, size_t* remLen );
 
 /** Add an integer property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -108,7 +133,7 @@ char* json_null( char* dest, char const* name, size_t* remLen );
   * @param value Value of the property.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_int( char* dest, char const* name, int value, size_t* remLen );
+JSON_MAKER_API char* json_int( char* dest, char const* name, int value, size_t* remLen );
 
 /** Add an unsigned integer property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -116,7 +141,7 @@ char* json_int( char* dest, char const* name, int value, size_t* remLen );
   * @param value Value of the property.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_uint( char* dest, char const* name, unsigned int value, size_t* remLen );
+JSON_MAKER_API char* json_uint( char* dest, char const* name, unsigned int value, size_t* remLen );
 
 /** Add a long integer property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -124,7 +149,7 @@ char* json_uint( char* dest, char const* name, unsigned int value, size_t* remLe
   * @param value Value of the property.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_long( char* dest, char const* name, long int value, size_t* remLen );
+JSON_MAKER_API char* json_long( char* dest, char const* name, long int value, size_t* remLen );
 
 /** Add an unsigned long integer property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -132,7 +157,7 @@ char* json_long( char* dest, char const* name, long int value, size_t* remLen );
   * @param value Value of the property.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_ulong( char* dest, char const* name, unsigned long int value, size_t* remLen );
+JSON_MAKER_API char* json_ulong( char* dest, char const* name, unsigned long int value, size_t* remLen );
 
 /** Add a long long integer property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -140,7 +165,7 @@ char* json_ulong( char* dest, char const* name, unsigned long int value, size_t*
   * @param value Value of the property.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_verylong( char* dest, char const* name, long long int value, size_t* remLen );
+JSON_MAKER_API char* json_verylong( char* dest, char const* name, long long int value, size_t* remLen );
 
 /** Add a double precision number property in a JSON string.
   * @param dest Pointer to the end of JSON under construction.
@@ -148,7 +173,17 @@ char* json_verylong( char* dest, char const* name, long long int value, size_t*
   * @param value Value of the property.
   * @param remLen Pointer to remaining length of dest
   * @return Pointer to the new end of JSON under construction. */
-char* json_double( char* dest, char const* name, double value, size_t* remLen );
+JSON_MAKER_API char* json_double( char* dest, char const* name, double value, size_t* remLen );
+
+/** Add a RFC 3339 UTC timestamp property in a JSON string.
+  * e.g. "name":"2026-10-18T12:34:56.123456Z",
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param epoch_ns Nanoseconds since 1970-01-01T00:00:00Z.
+  * @param precision Number of digits of the fraction of second, from 0 to 9.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+JSON_MAKER_API char* json_timestamp( char* dest, char const* name, int64_t epoch_ns, int precision, size_t* remLen );
 
 /** @ } */
 
@@ -156,5 +191,9 @@ char* json_double( char* dest, char const* name, double value, size_t* remLen );
 }
 #endif
 
+#ifdef JSON_MAKER_INLINE
+#include "json-maker/json-maker-impl.h"
+#endif
+
 #endif	/* MAKE_JSON_H */
 
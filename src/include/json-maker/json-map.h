@@ -0,0 +1,90 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+
+#ifndef JSON_MAP_H
+#define	JSON_MAP_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsonmap Memory-mapped files.
+  * JSON text is built directly in the page cache of a mapped file. The
+  * mapping grows as the document is built and the file is truncated to
+  * the exact length of the JSON text when it is closed.
+  * @{ */
+
+/** Flags of json_mapClose(). */
+enum {
+    json_mapAsync    = 1, /**< Start the write back with msync( MS_ASYNC ). */
+    json_mapDontNeed = 2, /**< Write the file back and drop its pages from the page
+                            *  cache with posix_fadvise(). It waits for the write back. */
+};
+
+/** Destination file mapped in memory. */
+struct jsonMap {
+    int fd;
+    char* base;
+    size_t size;
+    size_t window;
+    int error;
+};
+
+/** Create a file and map its first window.
+  * @param map Destination to be opened.
+  * @param path Path of the file. It is truncated if it exists.
+  * @param window Size in bytes the file grows each time. It must hold the
+  *               largest element written between two calls to json_mapSync()
+  *               and a spare character.
+  * @param remLen Pointer to remaining length of the mapping.
+  * @return Pointer to the start of JSON under construction or null if error. */
+char* json_mapOpen( struct jsonMap* map, char const* path, size_t window, size_t* remLen );
+
+/** Grow the file and its mapping if less than half window remains. Call it
+  * between elements, i.e. after a json_* function. The mapping can move.
+  * @param map Opened destination.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of the mapping.
+  * @return Pointer to the new end of JSON under construction. */
+char* json_mapSync( struct jsonMap* map, char* dest, size_t* remLen );
+
+/** Truncate the file to the length of the JSON text, unmap and close it.
+  * Call it after json_end().
+  * @param map Opened destination.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of the mapping.
+  * @param flags Zero or a combination of json_mapAsync and json_mapDontNeed.
+  * @return Zero on success. Non zero if the mapping overflowed or a system call failed. */
+int json_mapClose( struct jsonMap* map, char* dest, size_t* remLen, int flags );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_MAP_H */
@@ -0,0 +1,197 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/* Internal helpers to format numbers without snprintf and to copy short
+   texts. They are shared by the modules of the library and by the core
+   without snprintf. They are installed for json-maker-impl.h but they are
+   not part of the API. */
+
+#include <stddef.h>
+#include <math.h> // For signbit, a macro that needs no libm
+
+#ifndef JSON_NUM_H
+#define	JSON_NUM_H
+
+/** Max length of a formatted integer: sign and 20 digits. */
+enum { json_numMaxLen = 21 };
+
+/** Format an integer in decimal.
+  * @param dest Destination with room for json_numMaxLen characters.
+  * @param mag Magnitude of the number.
+  * @param neg Non zero if the number is negative.
+  * @return Length of the text. It is not null-terminated. */
+static inline size_t json_numtoa( char* dest, unsigned long long mag, int neg ) {
+    static char const lut[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char buff[ json_numMaxLen ];
+    char* p = buff + sizeof buff;
+    while( mag >= 100 ) {
+        unsigned const pair = (unsigned)( mag % 100 );
+        mag /= 100;
+        *--p = lut[ 2 * pair + 1 ];
+        *--p = lut[ 2 * pair ];
+    }
+    if ( mag >= 10 ) {
+        *--p = lut[ 2 * mag + 1 ];
+        *--p = lut[ 2 * mag ];
+    }
+    else
+        *--p = (char)( '0' + mag );
+    if ( neg )
+        *--p = '-';
+    size_t const len = buff + sizeof buff - p;
+    for( size_t i = 0; i < len; ++i )
+        dest[i] = p[i];
+    return len;
+}
+
+/** Format a signed integer in decimal.
+  * @param dest Destination with room for json_numMaxLen characters.
+  * @param val Value of the number.
+  * @return Length of the text. It is not null-terminated. */
+static inline size_t json_itoa( char* dest, long long val ) {
+    // The magnitude is computed as unsigned to support the minimum value.
+    unsigned long long const mag = 0 > val ? 0ull - (unsigned long long)val : (unsigned long long)val;
+    return json_numtoa( dest, mag, 0 > val );
+}
+
+/** Format an unsigned integer in decimal.
+  * @param dest Destination with room for json_numMaxLen characters.
+  * @param val Value of the number.
+  * @return Length of the text. It is not null-terminated. */
+static inline size_t json_utoa( char* dest, unsigned long long val ) {
+    return json_numtoa( dest, val, 0 );
+}
+
+/** Max length of a real number formatted by json_gtoa(). */
+enum { json_realMaxLen = sizeof "-1.23457e+308" - 1 };
+
+/** Format a real number like printf with "%g": six significant digits
+  * and exponent notation for very big or small magnitudes.
+  * @param dest Destination with room for json_realMaxLen characters.
+  * @param val Value to be formatted.
+  * @return Length of the text. It is not null-terminated. */
+static inline size_t json_gtoa( char* dest, double val ) {
+    enum { precision = 6 };
+    static double const powers[] = { 1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256 };
+    char* p = dest;
+    // The sign of zero and not-a-number is printed like the C library does.
+    if ( signbit( val ) ) {
+        *p++ = '-';
+        val = -val;
+    }
+    if ( val != val ) {
+        p[0] = 'n'; p[1] = 'a'; p[2] = 'n';
+        return p + 3 - dest;
+    }
+    if ( val > 1.7976931348623157e308 ) {
+        p[0] = 'i'; p[1] = 'n'; p[2] = 'f';
+        return p + 3 - dest;
+    }
+    if ( 0 == val ) {
+        p[0] = '0';
+        return p + 1 - dest;
+    }
+    // Scale the value to [1,10) and get its decimal exponent.
+    int exp = 0;
+    for( int i = sizeof powers / sizeof *powers - 1; i >= 0; --i ) {
+        if ( val >= powers[i] ) {
+            val /= powers[i];
+            exp += 1 << i;
+        }
+        else if ( val * powers[i] < 10 ) {
+            val *= powers[i];
+            exp -= 1 << i;
+        }
+    }
+    unsigned long digits = (unsigned long)( val * 1e5 + 0.5 );
+    if ( digits >= 1000000ul ) {
+        digits /= 10;
+        ++exp;
+    }
+    char num[ precision ];
+    for( int i = precision - 1; i >= 0; --i ) {
+        num[i] = (char)( '0' + digits % 10 );
+        digits /= 10;
+    }
+    int len = precision;
+    while( 1 < len && '0' == num[ len - 1 ] )
+        --len;
+    if ( -4 > exp || precision <= exp ) {
+        *p++ = num[0];
+        if ( 1 < len )
+            *p++ = '.';
+        for( int i = 1; i < len; ++i )
+            *p++ = num[i];
+        *p++ = 'e';
+        *p++ = 0 > exp ? '-' : '+';
+        if ( 0 > exp )
+            exp = -exp;
+        if ( 100 <= exp )
+            *p++ = (char)( '0' + exp / 100 );
+        *p++ = (char)( '0' + exp / 10 % 10 );
+        *p++ = (char)( '0' + exp % 10 );
+    }
+    else if ( 0 <= exp ) {
+        for( int i = 0; i <= exp; ++i )
+            *p++ = num[i];
+        if ( exp + 1 < len )
+            *p++ = '.';
+        for( int i = exp + 1; i < len; ++i )
+            *p++ = num[i];
+    }
+    else {
+        *p++ = '0';
+        *p++ = '.';
+        for( int i = -1; i > exp; --i )
+            *p++ = '0';
+        for( int i = 0; i < len; ++i )
+            *p++ = num[i];
+    }
+    return p - dest;
+}
+
+/** Copy a short text at the end of JSON under construction.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param text Text to be copied. It does not need a null character.
+  * @param len Length of the text.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static inline char* json_append( char* dest, void const* text, size_t len, size_t* remLen ) {
+    if ( len > *remLen )
+        len = *remLen;
+    // Texts are short. A plain loop is faster than a call to memcpy.
+    char const* src = text;
+    for( size_t i = 0; i < len; ++i )
+        dest[i] = src[i];
+    *remLen -= len;
+    dest += len;
+    *dest = '\0';
+    return dest;
+}
+
+#endif	/* JSON_NUM_H */
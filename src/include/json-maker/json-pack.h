@@ -0,0 +1,100 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+#include <stdarg.h>
+
+#ifndef JSON_PACK_H
+#define	JSON_PACK_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsonpack Pack formats.
+  * A format string that describes a JSON value is compiled once in a small
+  * program. The keys are quoted and the fixed text is merged in the program,
+  * so running it is faster than the equivalent sequence of json_* calls.
+  * A compiled program is never modified and can be run from many threads.
+  *
+  * Format: {temp:i,hum:i,tags:[s*]}
+  * - {key:value,...} An object. Keys are copied without escapes.
+  * - [value,...]     An array with a fixed number of values.
+  * - [x*]            An array of type x. It takes an int with the number of
+  *                   items and a pointer to the first one.
+  * - i int, u unsigned int, l long, L unsigned long, I long long,
+  *   d double, b boolean as int, s null-terminated string or null,
+  *   n null. It takes no argument.
+  * Objects and arrays can be nested up to JSON_PACK_DEPTH levels, 16 by
+  * default. The compiler is not recursive.
+  * @{ */
+
+/** Compile a pack format.
+  * @param prog Destination of the program.
+  * @param size Size of prog in bytes. Eight times the length of the format
+  *             is always enough.
+  * @param fmt Null-terminated pack format.
+  * @return Length of the program or zero if the format is not valid or
+  *         the program does not fit in prog. */
+size_t json_packCompile( unsigned char* prog, size_t size, char const* fmt );
+
+/** Add a property described by a compiled pack format in a JSON string.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param prog Program made by json_packCompile().
+  * @param remLen Pointer to remaining length of dest
+  * @param ... The values in the order of the format.
+  * @return Pointer to the new end of JSON under construction. */
+char* json_pack( char* dest, char const* name, unsigned char const* prog, size_t* remLen, ... );
+
+/** Add a property described by a compiled pack format in a JSON string.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param prog Program made by json_packCompile().
+  * @param remLen Pointer to remaining length of dest
+  * @param args The values in the order of the format.
+  * @return Pointer to the new end of JSON under construction. */
+char* json_vpack( char* dest, char const* name, unsigned char const* prog, size_t* remLen, va_list args );
+
+/** Add a property described by a compiled pack format in a JSON string.
+  * The values are read from the members of a structure.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param prog Program made by json_packCompile().
+  * @param src Pointer to the structure.
+  * @param offsets Offsets of the members in the order of the format, see
+  *                offsetof(). An array of type x takes two: an int member
+  *                with the number of items and a pointer member.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+char* json_spack( char* dest, char const* name, unsigned char const* prog, void const* src, size_t const* offsets, size_t* remLen );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_PACK_H */
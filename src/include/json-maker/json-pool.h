@@ -0,0 +1,118 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+
+#ifndef JSON_POOL_H
+#define	JSON_POOL_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsonpool Buffer pool.
+  * Output buffers are recycled in size classes instead of being allocated
+  * and freed for each document. Each thread gets and puts buffers through
+  * its own cache. The caches exchange buffers with lock-free global lists.
+  * @{ */
+
+enum {
+    json_poolMinSize = 256, /**< Size of the smallest class in bytes. */
+    json_poolClasses = 14,  /**< Number of classes. Each one doubles the previous one. */
+    json_poolCacheMax = 8,  /**< Max number of buffers of a class kept in a cache.
+                              *  An empty cache takes half of it from the pool. */
+};
+
+/** Header of a pooled buffer. It is private. */
+struct jsonPoolBuffer;
+
+/** Pool of buffers. It is shared by all the threads. */
+struct jsonPool {
+    struct jsonPoolBuffer* head[ json_poolClasses ];
+    size_t inuse[ json_poolClasses ];
+    size_t highwater[ json_poolClasses ];
+};
+
+/** Cache of a pool that is used by a single thread. */
+struct jsonPoolCache {
+    struct jsonPool* pool;
+    struct jsonPoolBuffer* head[ json_poolClasses ];
+    unsigned qty[ json_poolClasses ];
+};
+
+/** Initialize a pool.
+  * @param pool Pool to be initialized. */
+void json_poolInit( struct jsonPool* pool );
+
+/** Free the buffers of a pool. Buffers in use and buffers in caches
+  * are not freed. Flush the caches before.
+  * @param pool Pool to be released. */
+void json_poolFree( struct jsonPool* pool );
+
+/** Allocate buffers in advance, e.g. as many as the high-water mark of a
+  * previous run.
+  * @param pool Initialized pool.
+  * @param size Size of the buffers in bytes.
+  * @param qty Number of buffers.
+  * @return Zero on success. Non zero if the memory is exhausted. */
+int json_poolReserve( struct jsonPool* pool, size_t size, size_t qty );
+
+/** Get the max number of buffers of a class that were in use at once.
+  * @param pool Initialized pool.
+  * @param size A size of the class in bytes.
+  * @return The high-water mark or zero if the size is bigger than any class. */
+size_t json_poolHighWater( struct jsonPool const* pool, size_t size );
+
+/** Initialize the cache of a thread.
+  * @param cache Cache to be initialized.
+  * @param pool Pool of the cache. */
+void json_poolCacheInit( struct jsonPoolCache* cache, struct jsonPool* pool );
+
+/** Return all the buffers of a cache to its pool. Call it before the
+  * thread ends.
+  * @param cache Initialized cache. */
+void json_poolCacheFlush( struct jsonPoolCache* cache );
+
+/** Get a buffer.
+  * @param cache Cache of the current thread.
+  * @param size Min size of the buffer in bytes.
+  * @param capacity Destination of the actual size of the buffer. Can be null.
+  * @return Pointer to the buffer or null if the memory is exhausted or the
+  *         size is too large. */
+char* json_poolGet( struct jsonPoolCache* cache, size_t size, size_t* capacity );
+
+/** Return a buffer to the pool, e.g. when the response is done. It can be
+  * returned by a thread other than the one that got it.
+  * @param cache Cache of the current thread.
+  * @param buff Buffer from json_poolGet(). */
+void json_poolPut( struct jsonPoolCache* cache, char* buff );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_POOL_H */
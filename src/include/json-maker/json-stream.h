@@ -0,0 +1,122 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifndef JSON_STREAM_H
+#define	JSON_STREAM_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsonstream JSON streams.
+  * JSON text is built in a window of memory that is passed in chunks to a
+  * chain of output filters. The full document never has to fit in memory.
+  * @{ */
+
+/** Stage of an output filter chain. Each stage receives chunks of text and
+  * passes its own output to the next one. The last stage is the final sink. */
+struct jsonFilter {
+    /** Process a chunk of data. Return zero on success. */
+    int (*write)( struct jsonFilter* filter, void const* data, size_t len );
+    /** Flush pending data and release resources. Can be null.
+      * Return zero on success. */
+    int (*close)( struct jsonFilter* filter );
+    /** Next stage of the chain. Null for the final sink. */
+    struct jsonFilter* next;
+};
+
+/** Pass a chunk of data to a filter.
+  * @param filter Filter that receives the data.
+  * @param data Pointer to the data.
+  * @param len Length of the data in bytes.
+  * @return Zero on success. */
+static inline int json_filterWrite( struct jsonFilter* filter, void const* data, size_t len ) {
+    return filter->write( filter, data, len );
+}
+
+/** Close a filter and all the following stages of its chain.
+  * @param filter First filter to be closed.
+  * @return Zero on success. */
+int json_filterClose( struct jsonFilter* filter );
+
+/** Final sink that writes to a standard file. It is the only part of the
+  * streams that uses the C library so json_maker_tiny does not have it. */
+struct jsonFile {
+    struct jsonFilter filter;
+    FILE* file;
+};
+
+/** Initialize a file sink. The file is not closed with the chain.
+  * @param sink Sink to be initialized.
+  * @param file Opened file.
+  * @return Pointer to the filter interface of the sink. */
+struct jsonFilter* json_fileInit( struct jsonFile* sink, FILE* file );
+
+/** Window where the JSON text is built before being passed to a filter. */
+struct jsonStream {
+    char* buff;
+    size_t size;
+    struct jsonFilter* out;
+    int error;
+};
+
+/** Open a stream in a window of memory.
+  * @param stream Stream to be opened.
+  * @param buff Window memory. It must hold the largest element written
+  *             between two calls to json_streamSync() and a spare character.
+  *             The remaining length does not count the spare character, so
+  *             it is zero only if an element did not fit.
+  * @param size Size of the window in bytes. At least 3.
+  * @param out First filter of the output chain.
+  * @param remLen Pointer to remaining length of the window.
+  * @return Pointer to the end of JSON under construction. */
+char* json_streamOpen( struct jsonStream* stream, char* buff, size_t size, struct jsonFilter* out, size_t* remLen );
+
+/** Pass the text finished so far to the filter chain if the window is half
+  * full. Call it between elements, i.e. after a json_* function.
+  * @param stream Opened stream.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of the window.
+  * @return Pointer to the new end of JSON under construction. */
+char* json_streamSync( struct jsonStream* stream, char* dest, size_t* remLen );
+
+/** Pass the rest of the text to the filter chain and close it.
+  * Call it after json_end().
+  * @param stream Opened stream.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of the window.
+  * @return Zero on success. Non zero if the window overflowed or a filter failed. */
+int json_streamClose( struct jsonStream* stream, char* dest, size_t* remLen );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_STREAM_H */
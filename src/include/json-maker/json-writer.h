@@ -0,0 +1,110 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h>
+
+#ifndef JSON_WRITER_H
+#define	JSON_WRITER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/** @defgroup jsonwriter Resumable writer.
+  * A document is described as a sequence of steps that a callback builds
+  * with the usual json_* functions. The writer builds one step in its window,
+  * sends it and returns if the socket does not accept more. It continues at
+  * the same position when it is called again, so the memory of a connection
+  * is bounded by the window and not by the document.
+  * @{ */
+
+/** Results of json_writerRun(). */
+enum {
+    json_writerDone    =  0, /**< The whole document was sent. */
+    json_writerBlocked =  1, /**< The socket is full. Call again when it is writable. */
+    json_writerError   = -1  /**< A step overflowed the window or the socket failed. */
+};
+
+/** State of a resumable writer. */
+struct jsonWriter {
+    char* buff;
+    size_t size;
+    size_t head;         /**< First character of the window not sent yet. */
+    size_t tail;         /**< End of the text in the window. */
+    /** Build a step at the end of the document under construction.
+      * Return the new end of the document or null if there are no more steps. */
+    char* (*step)( struct jsonWriter* writer, char* dest, size_t* remLen );
+    void* ctx;           /**< User context of the step callback. */
+    unsigned index;      /**< Number of the next step, starting at zero. */
+    char const* str;     /**< Rest of a string being written or null. */
+    int strLen;          /**< Max length of the rest of the string. < 0 for unlimit. */
+    char const* strEnd;  /**< End of the step that left the string unfinished. */
+    int done;
+    int error;
+};
+
+/** Initialize a writer.
+  * @param writer Writer to be initialized.
+  * @param buff Window memory. It must hold the largest step.
+  * @param size Size of the window in bytes. At least 16.
+  * @param step Callback that builds the steps of the document.
+  * @param ctx User context of the step callback.
+  * @return Zero on success. Non zero if the window is too small. */
+int json_writerInit( struct jsonWriter* writer, char* buff, size_t size, char* (*step)( struct jsonWriter*, char*, size_t* ), void* ctx );
+
+/** Add a text property that can be longer than the window. Call it only
+  * from a step callback and as the last json_* function of the step:
+  * the part that does not fit is written in the next rounds.
+  * @param writer Writer that calls the step.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param value A valid null-terminated string. It must be valid until the
+  *              text is sent.
+  * @param len Max length of value. < 0 for unlimit.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+char* json_writerNstr( struct jsonWriter* writer, char* dest, char const* name, char const* value, int len, size_t* remLen );
+
+/** Add a text property that can be longer than the window.
+  * @see json_writerNstr() */
+static inline char* json_writerStr( struct jsonWriter* writer, char* dest, char const* name, char const* value, size_t* remLen ) {
+    return json_writerNstr( writer, dest, name, value, -1, remLen );
+}
+
+/** Build and send the document until it is finished or the socket is full.
+  * @param writer Initialized writer.
+  * @param send Write in a non-blocking socket. It returns the number of
+  *             bytes accepted, zero if it would block or negative on error.
+  * @param sock Socket passed to send.
+  * @return json_writerDone, json_writerBlocked or json_writerError. */
+int json_writerRun( struct jsonWriter* writer, long (*send)( void* sock, void const* data, size_t len ), void* sock );
+
+/** @ } */
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* JSON_WRITER_H */
@@ -0,0 +1,360 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#define _POSIX_C_SOURCE 200809L // For pwrite
+#define _FILE_OFFSET_BITS 64
+
+#include <stddef.h> // For NULL
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include "json-maker/json-async.h"
+
+/** Get the memory of a staging buffer. */
+static char* buffer( struct jsonAsync const* async, unsigned idx ) {
+    return async->mem + idx * async->size;
+}
+
+#ifdef JSON_MAKER_URING
+
+/** Queue the pending part of a staging buffer in the ring.
+  * @return Zero on success. */
+static int ringsubmit( struct jsonAsync* async, unsigned idx ) {
+    struct jsonAsyncSlot const* slot = &async->slot[ idx ];
+    struct io_uring_sqe* sqe = io_uring_get_sqe( &async->ring );
+    if ( NULL == sqe )
+        return -1;
+    // An offset of -1 means the current position. It is used for sockets and pipes.
+    unsigned long long const offset = 0 > slot->offset
+        ? (unsigned long long)-1
+        : (unsigned long long)( slot->offset + slot->done );
+    io_uring_prep_write( sqe, async->fd, buffer( async, idx ) + slot->done, (unsigned)( slot->len - slot->done ), offset );
+    io_uring_sqe_set_data( sqe, (void*)(uintptr_t)idx );
+    return 0 > io_uring_submit( &async->ring ) ? -1 : 0;
+}
+
+/** Wait for a completion. Short writes are queued again. */
+static void ringreap( struct jsonAsync* async ) {
+    struct io_uring_cqe* cqe;
+    int rslt;
+    do
+        rslt = io_uring_wait_cqe( &async->ring, &cqe );
+    while( -EINTR == rslt );
+    if ( 0 > rslt ) {
+        async->error = 1;
+        for( unsigned i = 0; i < async->qty; ++i )
+            async->slot[ i ].busy = 0;
+        async->inflight = 0;
+        return;
+    }
+    unsigned const idx = (unsigned)(uintptr_t)io_uring_cqe_get_data( cqe );
+    int const res = cqe->res;
+    io_uring_cqe_seen( &async->ring, cqe );
+    struct jsonAsyncSlot* slot = &async->slot[ idx ];
+    if ( 0 < res )
+        slot->done += (size_t)res;
+    else if ( -EINTR != res ) {
+        async->error = 1;
+        slot->done = slot->len;
+    }
+    if ( slot->done < slot->len && 0 == ringsubmit( async, idx ) )
+        return;
+    if ( slot->done < slot->len )
+        async->error = 1;
+    slot->busy = 0;
+    --async->inflight;
+}
+
+/** Queue the writes of a staging buffer in the ring. */
+static void ringenqueue( struct jsonAsync* async, unsigned idx ) {
+    // Writes to sockets and pipes must not be reordered so only one is in flight.
+    if ( 0 > async->offset )
+        while( 0 != async->inflight )
+            ringreap( async );
+    async->slot[ idx ].busy = 1;
+    ++async->inflight;
+    if ( 0 != ringsubmit( async, idx ) ) {
+        async->error = 1;
+        async->slot[ idx ].busy = 0;
+        --async->inflight;
+    }
+}
+
+/** Reap completions until a staging buffer is not in flight.
+  * @return Zero if no write has failed so far. */
+static int ringwait( struct jsonAsync* async, unsigned idx ) {
+    while( async->slot[ idx ].busy )
+        ringreap( async );
+    return async->error;
+}
+
+/** Set up the ring. */
+static int ringstart( struct jsonAsync* async ) {
+    async->inflight = 0;
+    return 0 > io_uring_queue_init( async->qty, &async->ring, 0 ) ? -1 : 0;
+}
+
+/** Wait for all the writes and release the ring.
+  * @return Zero if all the writes succeeded. */
+static int ringstop( struct jsonAsync* async ) {
+    while( 0 != async->inflight )
+        ringreap( async );
+    io_uring_queue_exit( &async->ring );
+    return async->error;
+}
+
+#endif
+
+/** Write a staging buffer completely.
+  * @return Zero on success. */
+static int writeall( struct jsonAsync* async, unsigned idx ) {
+    struct jsonAsyncSlot* slot = &async->slot[ idx ];
+    char const* const buff = buffer( async, idx );
+    while( slot->done < slot->len ) {
+        size_t const len = slot->len - slot->done;
+        ssize_t const rslt = 0 > slot->offset
+            ? write( async->fd, buff + slot->done, len )
+            : pwrite( async->fd, buff + slot->done, len, (off_t)( slot->offset + slot->done ) );
+        if ( 0 < rslt )
+            slot->done += (size_t)rslt;
+        else if ( 0 > rslt && EINTR == errno )
+            continue;
+        else
+            return -1;
+    }
+    return 0;
+}
+
+/** Writer thread. It writes the queued buffers in order. */
+static void* writer( void* arg ) {
+    struct jsonAsync* async = arg;
+    pthread_mutex_lock( &async->mutex );
+    for(;;) {
+        while( 0 == async->queued && !async->stop )
+            pthread_cond_wait( &async->cond, &async->mutex );
+        if ( 0 == async->queued )
+            break;
+        unsigned const idx = async->head;
+        pthread_mutex_unlock( &async->mutex );
+        int const err = writeall( async, idx );
+        pthread_mutex_lock( &async->mutex );
+        if ( err )
+            async->failed = 1;
+        async->slot[ idx ].busy = 0;
+        async->head = ( idx + 1 ) % async->qty;
+        --async->queued;
+        pthread_cond_broadcast( &async->cond );
+    }
+    pthread_mutex_unlock( &async->mutex );
+    return NULL;
+}
+
+/** Queue a staging buffer for the writer thread. */
+static void threadenqueue( struct jsonAsync* async, unsigned idx ) {
+    pthread_mutex_lock( &async->mutex );
+    async->slot[ idx ].busy = 1;
+    ++async->queued;
+    pthread_cond_broadcast( &async->cond );
+    pthread_mutex_unlock( &async->mutex );
+}
+
+/** Wait until the writer thread releases a staging buffer.
+  * @return Zero if no write has failed so far. */
+static int threadwait( struct jsonAsync* async, unsigned idx ) {
+    pthread_mutex_lock( &async->mutex );
+    while( async->slot[ idx ].busy )
+        pthread_cond_wait( &async->cond, &async->mutex );
+    int const failed = async->failed;
+    pthread_mutex_unlock( &async->mutex );
+    return failed;
+}
+
+/** Start the writer thread. */
+static int threadstart( struct jsonAsync* async ) {
+    async->head   = 0;
+    async->queued = 0;
+    async->stop   = 0;
+    async->failed = 0;
+    if ( 0 != pthread_mutex_init( &async->mutex, NULL ) )
+        return -1;
+    if ( 0 != pthread_cond_init( &async->cond, NULL ) ) {
+        pthread_mutex_destroy( &async->mutex );
+        return -1;
+    }
+    if ( 0 != pthread_create( &async->thread, NULL, writer, async ) ) {
+        pthread_cond_destroy( &async->cond );
+        pthread_mutex_destroy( &async->mutex );
+        return -1;
+    }
+    return 0;
+}
+
+/** Wait for all the writes and stop the writer thread.
+  * @return Zero if all the writes succeeded. */
+static int threadstop( struct jsonAsync* async ) {
+    pthread_mutex_lock( &async->mutex );
+    async->stop = 1;
+    pthread_cond_broadcast( &async->cond );
+    pthread_mutex_unlock( &async->mutex );
+    pthread_join( async->thread, NULL );
+    pthread_cond_destroy( &async->cond );
+    pthread_mutex_destroy( &async->mutex );
+    return async->failed;
+}
+
+
+/** Start the writes of a staging buffer. */
+static void enqueue( struct jsonAsync* async, unsigned idx ) {
+#ifdef JSON_MAKER_URING
+    if ( async->uring ) {
+        ringenqueue( async, idx );
+        return;
+    }
+#endif
+    threadenqueue( async, idx );
+}
+
+/** Wait until a staging buffer is not in flight.
+  * @return Zero if no write has failed so far. */
+static int waitslot( struct jsonAsync* async, unsigned idx ) {
+#ifdef JSON_MAKER_URING
+    if ( async->uring )
+        return ringwait( async, idx );
+#endif
+    return threadwait( async, idx );
+}
+
+/** Set up io_uring or start the writer thread if it is not available. */
+static int startio( struct jsonAsync* async ) {
+#ifdef JSON_MAKER_URING
+    // io_uring can be missing at run time in old kernels, in containers or
+    // with seccomp filters.
+    async->uring = 0 == ringstart( async );
+    if ( async->uring )
+        return 0;
+#else
+    async->uring = 0;
+#endif
+    return threadstart( async );
+}
+
+/** Wait for all the writes and release the back end.
+  * @return Zero if all the writes succeeded. */
+static int stopio( struct jsonAsync* async ) {
+#ifdef JSON_MAKER_URING
+    if ( async->uring )
+        return ringstop( async );
+#endif
+    return threadstop( async );
+}
+
+
+/** Start the writes of the first len bytes of the current staging buffer. */
+static void flush( struct jsonAsync* async, size_t len ) {
+    struct jsonAsyncSlot* slot = &async->slot[ async->cur ];
+    slot->len    = len;
+    slot->done   = 0;
+    slot->offset = async->offset;
+    if ( 0 <= async->offset )
+        async->offset += (long long)len;
+    enqueue( async, async->cur );
+}
+
+/* Open an asynchronous sink. */
+char* json_asyncOpen( struct jsonAsync* async, int fd, char* mem, size_t size, unsigned qty, size_t* remLen ) {
+    *remLen = 0;
+    if ( 2 > qty || json_asyncMaxBuffers < qty || 3 > size || UINT_MAX < size )
+        return NULL;
+    // Both back ends wait until a buffer is written. With a non-blocking
+    // descriptor the ring would spin on EAGAIN and the thread would fail.
+    int const flags = fcntl( fd, F_GETFL );
+    if ( 0 > flags || 0 != ( flags & O_NONBLOCK ) )
+        return NULL;
+    async->fd    = fd;
+    async->mem   = mem;
+    async->size  = size;
+    async->qty   = qty;
+    async->cur   = 0;
+    async->error = 0;
+    off_t const pos = lseek( fd, 0, SEEK_CUR );
+    async->offset = 0 > pos ? -1 : (long long)pos;
+    for( unsigned i = 0; i < qty; ++i )
+        async->slot[ i ].busy = 0;
+    if ( 0 != startio( async ) )
+        return NULL;
+    // A character of the buffer is spare so that a remaining length of zero
+    // always means that an element did not fit.
+    *remLen = size - 2;
+    *mem = '\0';
+    return mem;
+}
+
+/* Send the text finished so far if the staging buffer is half full. */
+char* json_asyncSync( struct jsonAsync* async, char* dest, size_t* remLen ) {
+    size_t const len = dest - buffer( async, async->cur );
+    if ( 0 == *remLen )
+        async->error = 1;
+    if ( async->error ) {
+        *remLen = 0;
+        return dest;
+    }
+    if ( len <= async->size / 2 )
+        return dest;
+    // The last character is kept because json_objClose(), json_arrClose()
+    // and json_end() can remove a trailing comma.
+    char const last = dest[-1];
+    flush( async, len - 1 );
+    unsigned const next = ( async->cur + 1 ) % async->qty;
+    // A failed write stops the serialization here instead of at the close.
+    if ( 0 != waitslot( async, next ) || async->error ) {
+        async->error = 1;
+        *remLen = 0;
+        return dest;
+    }
+    async->cur = next;
+    char* const buff = buffer( async, next );
+    buff[0] = last;
+    buff[1] = '\0';
+    *remLen = async->size - 3;
+    return buff + 1;
+}
+
+/* Send the rest of the text, wait for all the writes and release the sink. */
+int json_asyncClose( struct jsonAsync* async, char* dest, size_t* remLen ) {
+    size_t const len = dest - buffer( async, async->cur );
+    if ( 0 == *remLen )
+        async->error = 1;
+    *remLen = 0;
+    if ( !async->error && 0 != len )
+        flush( async, len );
+    if ( 0 != stopio( async ) )
+        async->error = 1;
+    if ( 0 <= async->offset )
+        lseek( async->fd, (off_t)async->offset, SEEK_SET );
+    return async->error ? -1 : 0;
+}
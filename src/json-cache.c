@@ -0,0 +1,123 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include <string.h>
+#include "json-maker/json-cache.h"
+#include "json-maker/json-num.h"
+
+#ifndef __GNUC__
+#error "The subtree cache needs the __atomic builtins of GCC or Clang."
+#endif
+
+/* Initialize a cache. */
+int json_cacheInit( struct jsonCache* cache, char* mem, size_t size,
+                    char* (*build)( char* dest, char const* name, void* ctx, size_t* remLen ), void* ctx ) {
+    if ( NULL == mem || size < 4 )
+        return -1;
+    cache->size = size / 2;
+    for( int i = 0; i < 2; ++i ) {
+        cache->slot[i].buff = mem + i * cache->size;
+        cache->slot[i].len = 0;
+        cache->slot[i].version = 0;
+        cache->slot[i].readers = 0;
+    }
+    cache->active = NULL;
+    cache->busy = 0;
+    cache->build = build;
+    cache->ctx = ctx;
+    return 0;
+}
+
+/** Get the active slot and register the current thread as its reader.
+  * A slot is not modified while it has readers.
+  * @return The active slot or null if there is none. */
+static struct jsonCacheSlot* acquire( struct jsonCache* cache ) {
+    for(;;) {
+        struct jsonCacheSlot* slot = __atomic_load_n( &cache->active, __ATOMIC_SEQ_CST );
+        if ( NULL == slot )
+            return NULL;
+        __atomic_add_fetch( &slot->readers, 1, __ATOMIC_SEQ_CST );
+        // The slot could have been replaced before it was registered.
+        if ( slot == __atomic_load_n( &cache->active, __ATOMIC_SEQ_CST ) )
+            return slot;
+        __atomic_sub_fetch( &slot->readers, 1, __ATOMIC_SEQ_CST );
+    }
+}
+
+/** Unregister a reader of a slot. */
+static void release( struct jsonCacheSlot* slot ) {
+    __atomic_sub_fetch( &slot->readers, 1, __ATOMIC_RELEASE );
+}
+
+/** Copy a new version of the value in the slot that is not active and
+  * publish it. The caller holds the busy flag so only one thread stores.
+  * @param cache Initialized cache.
+  * @param version Version of the value.
+  * @param text Value just built in a document.
+  * @param len Length of the value. */
+static void store( struct jsonCache* cache, uint64_t version, char const* text, size_t len ) {
+    struct jsonCacheSlot* const active = __atomic_load_n( &cache->active, __ATOMIC_SEQ_CST );
+    struct jsonCacheSlot* const slot = active == &cache->slot[0] ? &cache->slot[1] : &cache->slot[0];
+    if ( len > cache->size || ( NULL != active && version == active->version ) )
+        return;
+    // Readers of a previous version could be still copying it.
+    if ( 0 != __atomic_load_n( &slot->readers, __ATOMIC_SEQ_CST ) )
+        return;
+    memcpy( slot->buff, text, len );
+    slot->len = len;
+    slot->version = version;
+    __atomic_store_n( &cache->active, slot, __ATOMIC_SEQ_CST );
+}
+
+/* Add the cached value as a property in a JSON string. */
+char* json_cache( char* dest, char const* name, struct jsonCache* cache, uint64_t version, size_t* remLen ) {
+    if ( NULL != name ) {
+        dest = json_append( dest, "\"", 1, remLen );
+        dest = json_append( dest, name, strlen( name ), remLen );
+        dest = json_append( dest, "\":", 2, remLen );
+    }
+    struct jsonCacheSlot* const slot = acquire( cache );
+    if ( NULL != slot && version == slot->version ) {
+        // The cached value ends with a comma like any other value.
+        size_t const len = slot->len < *remLen ? slot->len : *remLen;
+        memcpy( dest, slot->buff, len );
+        release( slot );
+        *remLen -= len;
+        dest += len;
+        *dest = '\0';
+        return dest;
+    }
+    if ( NULL != slot )
+        release( slot );
+    // The value is built in the document and then it is copied in the cache.
+    char const* const start = dest;
+    dest = cache->build( dest, NULL, cache->ctx, remLen );
+    if ( 0 != *remLen && !__atomic_exchange_n( &cache->busy, 1, __ATOMIC_ACQUIRE ) ) {
+        store( cache, version, start, (size_t)( dest - start ) );
+        __atomic_store_n( &cache->busy, 0, __ATOMIC_RELEASE );
+    }
+    return dest;
+}
@@ -0,0 +1,281 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include <string.h>
+#include "json-maker/json-maker.h"
+#include "json-maker/json-column.h"
+#include "json-maker/json-num.h"
+
+#ifndef JSON_COLUMN_CELLS
+/** Number of formatted numbers of a tile. Each one takes 24 bytes of stack. */
+#define JSON_COLUMN_CELLS 256
+#endif
+
+#ifndef JSON_COLUMN_MAX
+/** Max number of columns of the fast path. Each one takes 40 bytes of stack
+  * on 64-bit targets. */
+#define JSON_COLUMN_MAX 64
+#endif
+
+#ifndef JSON_COLUMN_KEYS
+/** Size of the stack buffer for the quoted keys of the fast path. */
+#define JSON_COLUMN_KEYS 1024
+#endif
+
+/** Limits of the fast path. Wider schemas use the regular json_* calls. */
+enum {
+    maxColumns = JSON_COLUMN_MAX, /**< Max number of columns. */
+    keysSize   = JSON_COLUMN_KEYS /**< Size of the buffer for the quoted keys. */
+};
+
+/** A formatted number with its comma. */
+struct cell {
+    unsigned char len;
+    char text[ 23 ];
+};
+
+/** A column ready to be written. */
+struct field {
+    struct jsonColumn const* col;
+    size_t step;     /**< Bytes between the values of two rows. */
+    char const* key; /**< Quoted key with its colon. */
+    size_t keyLen;
+    int cell;        /**< Index of the cell in a row or -1 if it has none. */
+};
+
+/** Get the size of a value of a column type. */
+static size_t typesize( int type ) {
+    switch( type ) {
+        case 'i': return sizeof( int );
+        case 'u': return sizeof( unsigned );
+        case 'l': return sizeof( long );
+        case 'L': return sizeof( unsigned long );
+        case 'I': return sizeof( long long );
+        case 'd': return sizeof( double );
+        case 'b': return sizeof( int );
+        case 's': return sizeof( char const* );
+        default:  return 0;
+    }
+}
+
+/** Check if the values of a column type are formatted in cells. */
+static int isnumber( int type ) {
+    return '\0' != type && NULL != strchr( "iulLId", type );
+}
+
+/** Get a pointer to a value of a column.
+  * @param col Column.
+  * @param step Bytes between the values of two rows.
+  * @param row Index of the row.
+  * @return Pointer to the value. */
+static void const* value( struct jsonColumn const* col, size_t step, size_t row ) {
+    return (char const*)col->data + row * step;
+}
+
+/** Add a property of a row with the regular json_* calls.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param col Column of the property.
+  * @param step Bytes between the values of two rows.
+  * @param row Index of the row.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* property( char* dest, char const* name, struct jsonColumn const* col, size_t step, size_t row, size_t* remLen ) {
+    void const* const p = value( col, step, row );
+    switch( col->type ) {
+        case 'i': return json_int( dest, name, *(int const*)p, remLen );
+        case 'u': return json_uint( dest, name, *(unsigned const*)p, remLen );
+        case 'l': return json_long( dest, name, *(long const*)p, remLen );
+        case 'L': return json_ulong( dest, name, *(unsigned long const*)p, remLen );
+        case 'I': return json_verylong( dest, name, *(long long const*)p, remLen );
+        case 'd': return json_double( dest, name, *(double const*)p, remLen );
+        case 'b': return json_bool( dest, name, *(int const*)p, remLen );
+        case 's': {
+            char const* const str = *(char const* const*)p;
+            return NULL == str ? json_null( dest, name, remLen ) : json_str( dest, name, str, remLen );
+        }
+        default:  return json_null( dest, name, remLen );
+    }
+}
+
+/** Format a value of each row of a tile in its cell. */
+#define numbers( func, type )                                           \
+    for( size_t i = 0; i < qty; ++i, p += step, cell += next ) {        \
+        size_t const len = func( cell->text, *(type const*)p );        \
+        cell->text[ len ] = ',';                                        \
+        cell->len = (unsigned char)( len + 1 );                         \
+    }
+
+/** Format the values of a numeric column for a tile of rows.
+  * Real numbers are formatted like "%g" without a call to snprintf per value.
+  * @param cell Cell of the first row of the tile.
+  * @param next Number of cells between the cells of two rows.
+  * @param f Column.
+  * @param row Index of the first row of the tile.
+  * @param qty Number of rows of the tile. */
+static void format( struct cell* cell, size_t next, struct field const* f, size_t row, size_t qty ) {
+    size_t const step = f->step;
+    char const* p = value( f->col, step, row );
+    switch( f->col->type ) {
+        case 'i': numbers( json_itoa, int ); break;
+        case 'u': numbers( json_utoa, unsigned ); break;
+        case 'l': numbers( json_itoa, long ); break;
+        case 'L': numbers( json_utoa, unsigned long ); break;
+        case 'I': numbers( json_itoa, long long ); break;
+        default:  numbers( json_gtoa, double ); break;
+    }
+}
+
+#undef numbers
+
+/** Add a row as an object with the keys and cells already formatted.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param f Columns.
+  * @param qty Number of columns.
+  * @param cells Cells of the row.
+  * @param row Index of the row.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* object( char* dest, struct field const* f, int qty, struct cell const* cells, size_t row, size_t* remLen ) {
+    dest = json_append( dest, "{", 1, remLen );
+    for( int i = 0; i < qty; ++i, ++f ) {
+        dest = json_append( dest, f->key, f->keyLen, remLen );
+        if ( 0 <= f->cell )
+            dest = json_append( dest, cells[ f->cell ].text, cells[ f->cell ].len, remLen );
+        else if ( 'b' == f->col->type )
+            dest = *(int const*)value( f->col, f->step, row ) ?
+                json_append( dest, "true,", 5, remLen ) :
+                json_append( dest, "false,", 6, remLen );
+        else
+            dest = property( dest, NULL, f->col, f->step, row, remLen );
+    }
+    if ( ',' == dest[-1] ) {
+        --dest;
+        ++*remLen;
+    }
+    return json_append( dest, "},", 2, remLen );
+}
+
+/** Add the rows one property at a time with the regular json_* calls.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param cols Columns.
+  * @param qty Number of columns.
+  * @param rows Number of rows.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* slow( char* dest, struct jsonColumn const* cols, int qty, size_t rows, size_t* remLen ) {
+    for( size_t row = 0; row < rows && 0 != *remLen; ++row ) {
+        dest = json_objOpen( dest, NULL, remLen );
+        for( int i = 0; i < qty; ++i ) {
+            size_t const step = cols[i].stride ? cols[i].stride : typesize( cols[i].type );
+            dest = property( dest, cols[i].name, cols + i, step, row, remLen );
+        }
+        dest = json_objClose( dest, remLen );
+    }
+    return dest;
+}
+
+/** Quote the keys and assign the cells of the numeric columns.
+  * The columns must have been checked with fits().
+  * @param f Destination of the fields.
+  * @param keys Destination of the quoted keys.
+  * @param cols Columns.
+  * @param qty Number of columns.
+  * @return Number of cells of a row. */
+static int layout( struct field* f, char* keys, struct jsonColumn const* cols, int qty ) {
+    int cells = 0;
+    size_t rem = keysSize - 1;
+    for( int i = 0; i < qty; ++i ) {
+        char* const key = keys;
+        keys = json_append( keys, "\"", 1, &rem );
+        keys = json_append( keys, cols[i].name, strlen( cols[i].name ), &rem );
+        keys = json_append( keys, "\":", 2, &rem );
+        f[i].col = cols + i;
+        f[i].step = cols[i].stride ? cols[i].stride : typesize( cols[i].type );
+        f[i].key = key;
+        f[i].keyLen = (size_t)( keys - key );
+        f[i].cell = isnumber( cols[i].type ) ? cells++ : -1;
+    }
+    return cells;
+}
+
+/** Check the columns and whether they fit in the buffers of the fast path.
+  * @param cols Columns.
+  * @param qty Number of columns.
+  * @return 1 for the fast path, 0 for the slow one or -1 if a column has no name. */
+static int fits( struct jsonColumn const* cols, int qty ) {
+    size_t keys = 0;
+    int cells = 0;
+    for( int i = 0; i < qty; ++i ) {
+        if ( NULL == cols[i].name )
+            return -1;
+        keys += strlen( cols[i].name ) + sizeof "\"\":" - 1;
+        cells += isnumber( cols[i].type );
+    }
+    return qty <= maxColumns && keys < keysSize - 1 && cells <= JSON_COLUMN_CELLS;
+}
+
+/** Add the rows with the keys quoted once and the numbers formatted in tiles.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param cols Columns checked with fits().
+  * @param qty Number of columns.
+  * @param rows Number of rows.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+#ifdef __GNUC__
+// Its buffers stay in its own frame, so the slow path does not reserve them.
+__attribute__(( noinline ))
+#endif
+static char* fast( char* dest, struct jsonColumn const* cols, int qty, size_t rows, size_t* remLen ) {
+    struct field fields[ maxColumns ];
+    char keys[ keysSize ];
+    int const numbers = layout( fields, keys, cols, qty );
+    // Rows are written in tiles. The numbers of a tile are formatted column
+    // by column, so each column is read sequentially and the calls are few.
+    struct cell cells[ JSON_COLUMN_CELLS ];
+    size_t const tile = numbers ? JSON_COLUMN_CELLS / numbers : JSON_COLUMN_CELLS;
+    for( size_t row = 0; row < rows && 0 != *remLen; row += tile ) {
+        size_t const len = rows - row < tile ? rows - row : tile;
+        for( int i = 0; i < qty; ++i )
+            if ( 0 <= fields[i].cell )
+                format( cells + fields[i].cell, numbers, fields + i, row, len );
+        for( size_t i = 0; i < len; ++i )
+            dest = object( dest, fields, qty, cells + i * numbers, row + i, remLen );
+    }
+    return dest;
+}
+
+/* Add an array of objects made from columns in a JSON string. */
+char* json_columns( char* dest, char const* name, struct jsonColumn const* cols, int qty, size_t rows, size_t* remLen ) {
+    int const path = fits( cols, qty );
+    if ( 0 > path ) {
+        *remLen = 0;
+        return dest;
+    }
+    dest = json_arrOpen( dest, name, remLen );
+    dest = path ? fast( dest, cols, qty, rows, remLen ) : slow( dest, cols, qty, rows, remLen );
+    return json_arrClose( dest, remLen );
+}
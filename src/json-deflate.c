@@ -0,0 +1,98 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include "json-maker/json-deflate.h"
+
+/** Run the compressor and pass its output to the next filter.
+  * Compressed data is only passed in full buffers until the end of stream.
+  * @param df Deflate filter.
+  * @param flush Z_NO_FLUSH or Z_FINISH.
+  * @return Zero on success. */
+static int dfrun( struct jsonDeflate* df, int flush ) {
+    for(;;) {
+        int const rslt = deflate( &df->strm, flush );
+        if ( Z_STREAM_ERROR == rslt )
+            return -1;
+        int const done = Z_FINISH == flush ? Z_STREAM_END == rslt : 0 != df->strm.avail_out;
+        size_t const len = df->size - df->strm.avail_out;
+        if ( 0 == df->strm.avail_out || ( done && Z_FINISH == flush && 0 != len ) ) {
+            if ( 0 != json_filterWrite( df->filter.next, df->buff, len ) )
+                return -1;
+            df->strm.next_out  = df->buff;
+            df->strm.avail_out = (uInt)df->size;
+        }
+        if ( done )
+            return 0;
+    }
+}
+
+/** Compress a chunk of JSON text. */
+static int dfwrite( struct jsonFilter* filter, void const* data, size_t len ) {
+    struct jsonDeflate* df = (struct jsonDeflate*)filter;
+    // avail_in is an uInt so big chunks are compressed in several steps.
+    unsigned char const* src = data;
+    while( 0 != len ) {
+        uInt const step = len > 0x40000000u ? 0x40000000u : (uInt)len;
+        df->strm.next_in  = (unsigned char*)src;
+        df->strm.avail_in = step;
+        if ( 0 != dfrun( df, Z_NO_FLUSH ) )
+            return -1;
+        src += step;
+        len -= step;
+    }
+    return 0;
+}
+
+/** Finish the compressed stream and release the compressor. */
+static int dfclose( struct jsonFilter* filter ) {
+    struct jsonDeflate* df = (struct jsonDeflate*)filter;
+    df->strm.next_in  = NULL;
+    df->strm.avail_in = 0;
+    int const rslt = dfrun( df, Z_FINISH );
+    deflateEnd( &df->strm );
+    return rslt;
+}
+
+/* Initialize a deflate filter. */
+struct jsonFilter* json_deflateInit( struct jsonDeflate* df, int level, int gzip, unsigned char* buff, size_t size, struct jsonFilter* next ) {
+    enum { windowBits = 15, gzipBits = 16, memLevel = 8 };
+    if ( NULL == next || NULL == buff || 0 == size || size > 0x40000000u )
+        return NULL;
+    df->strm.zalloc = Z_NULL;
+    df->strm.zfree  = Z_NULL;
+    df->strm.opaque = Z_NULL;
+    int const bits = gzip ? windowBits + gzipBits : windowBits;
+    if ( Z_OK != deflateInit2( &df->strm, level, Z_DEFLATED, bits, memLevel, Z_DEFAULT_STRATEGY ) )
+        return NULL;
+    df->strm.next_out  = buff;
+    df->strm.avail_out = (uInt)size;
+    df->buff = buff;
+    df->size = size;
+    df->filter.write = dfwrite;
+    df->filter.close = dfclose;
+    df->filter.next  = next;
+    return &df->filter;
+}
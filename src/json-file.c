@@ -0,0 +1,49 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include <stdio.h>
+#include "json-maker/json-stream.h"
+
+/** Write a chunk in a file sink. */
+static int filewrite( struct jsonFilter* filter, void const* data, size_t len ) {
+    struct jsonFile* sink = (struct jsonFile*)filter;
+    return len == fwrite( data, 1, len, sink->file ) ? 0 : -1;
+}
+
+/** Flush a file sink. */
+static int fileclose( struct jsonFilter* filter ) {
+    struct jsonFile* sink = (struct jsonFile*)filter;
+    return 0 == fflush( sink->file ) ? 0 : -1;
+}
+
+/* Initialize a file sink. */
+struct jsonFilter* json_fileInit( struct jsonFile* sink, FILE* file ) {
+    sink->filter.write = filewrite;
+    sink->filter.close = fileclose;
+    sink->filter.next  = NULL;
+    sink->file = file;
+    return &sink->filter;
+}
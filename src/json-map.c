@@ -0,0 +1,130 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#define _GNU_SOURCE // For mremap
+#define _FILE_OFFSET_BITS 64
+
+#include <stddef.h> // For NULL
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "json-maker/json-map.h"
+
+/** Resize the file and its mapping.
+  * @param map Opened destination.
+  * @param size New size in bytes.
+  * @return Zero on success. */
+static int resize( struct jsonMap* map, size_t size ) {
+    if ( 0 != ftruncate( map->fd, (off_t)size ) )
+        return -1;
+#ifdef MREMAP_MAYMOVE
+    void* base = mremap( map->base, map->size, size, MREMAP_MAYMOVE );
+    if ( MAP_FAILED == base )
+        return -1;
+#else
+    // The file is mapped again before the old mapping is released. Both
+    // share the page cache so nothing is copied.
+    void* base = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, map->fd, 0 );
+    if ( MAP_FAILED == base )
+        return -1;
+    munmap( map->base, map->size );
+#endif
+    map->base = base;
+    map->size = size;
+    return 0;
+}
+
+/* Create a file and map its first window. */
+char* json_mapOpen( struct jsonMap* map, char const* path, size_t window, size_t* remLen ) {
+    long const page = sysconf( _SC_PAGESIZE );
+    size_t const align = 0 < page ? (size_t)page : 4096;
+    map->window = 0 == window ? align : ( window + align - 1 ) / align * align;
+    map->base   = NULL;
+    map->size   = 0;
+    map->error  = 0;
+    *remLen = 0;
+    map->fd = open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    if ( 0 > map->fd )
+        return NULL;
+    if ( 0 != ftruncate( map->fd, (off_t)map->window ) )
+        goto error;
+    void* base = mmap( NULL, map->window, PROT_READ | PROT_WRITE, MAP_SHARED, map->fd, 0 );
+    if ( MAP_FAILED == base )
+        goto error;
+    map->base = base;
+    map->size = map->window;
+    // A character of the mapping is spare so that a remaining length of zero
+    // always means that an element did not fit.
+    *remLen = map->size - 2;
+    *map->base = '\0';
+    return map->base;
+error:
+    close( map->fd );
+    map->fd = -1;
+    return NULL;
+}
+
+/* Grow the file and its mapping if less than half window remains. */
+char* json_mapSync( struct jsonMap* map, char* dest, size_t* remLen ) {
+    if ( 0 == *remLen )
+        map->error = 1;
+    if ( map->error || *remLen >= map->window / 2 )
+        return dest;
+    size_t const len = dest - map->base;
+    if ( 0 != resize( map, map->size + map->window ) ) {
+        map->error = 1;
+        return dest;
+    }
+    *remLen = map->size - len - 2;
+    return map->base + len;
+}
+
+/* Truncate the file to the length of the JSON text, unmap and close it. */
+int json_mapClose( struct jsonMap* map, char* dest, size_t* remLen, int flags ) {
+    if ( 0 == *remLen )
+        map->error = 1;
+    *remLen = 0;
+    if ( NULL == map->base )
+        return -1;
+    size_t const len = dest - map->base;
+    // The file is truncated first so that no write back is started for the
+    // pages beyond the end of the JSON text.
+    if ( 0 != ftruncate( map->fd, (off_t)len ) )
+        map->error = 1;
+    if ( ( flags & json_mapAsync ) && 0 != len && 0 != msync( map->base, len, MS_ASYNC ) )
+        map->error = 1;
+    if ( 0 != munmap( map->base, map->size ) )
+        map->error = 1;
+    // Dirty pages cannot be dropped from the page cache so they are written
+    // back before the advice.
+    if ( ( flags & json_mapDontNeed ) && !map->error )
+        if ( 0 != fdatasync( map->fd ) || 0 != posix_fadvise( map->fd, 0, (off_t)len, POSIX_FADV_DONTNEED ) )
+            map->error = 1;
+    if ( 0 != close( map->fd ) )
+        map->error = 1;
+    map->base = NULL;
+    map->fd = -1;
+    return map->error ? -1 : 0;
+}
@@ -0,0 +1,399 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include <string.h>
+#include "json-maker/json-maker.h"
+#include "json-maker/json-pack.h"
+#include "json-maker/json-num.h"
+
+#ifndef JSON_PACK_DEPTH
+/** Max number of nested objects and arrays of a format. */
+#define JSON_PACK_DEPTH 16
+#endif
+
+/** Operation codes of a compiled program. */
+enum {
+    op_end,   /**< End of the program. */
+    op_lit,   /**< Copy a literal. Followed by its length and its text. */
+    op_close, /**< Remove a trailing comma and copy a literal. */
+    op_array, /**< Array of values. Followed by the type of the items. */
+    op_int, op_uint, op_long, op_ulong, op_verylong, op_double, op_bool, op_str,
+};
+
+/** Get the operation code of a value type.
+  * @param ch Type character of the format.
+  * @return The operation code or op_end if it is not a type. */
+static int typetoop( int ch ) {
+    static struct { char ch; unsigned char op; } const pair[] = {
+        { 'i', op_int    }, { 'u', op_uint   }, { 'l', op_long     }, { 'L', op_ulong },
+        { 'I', op_verylong }, { 'd', op_double }, { 'b', op_bool   }, { 's', op_str   },
+    };
+    for( size_t i = 0; i < sizeof pair / sizeof *pair; ++i )
+        if ( ch == pair[i].ch )
+            return pair[i].op;
+    return op_end;
+}
+
+/** State of the compiler. The literal under construction is pending until
+  * an operation with a value or the end of the program is emitted. */
+struct compiler {
+    unsigned char* prog;
+    size_t size;
+    size_t len;
+    char const* fmt;
+    char lit[255];
+    size_t litlen;
+    int close;
+    int error;
+};
+
+/** Append a byte to the program. */
+static void emit( struct compiler* c, int byte ) {
+    if ( c->len < c->size )
+        c->prog[ c->len++ ] = (unsigned char)byte;
+    else
+        c->error = 1;
+}
+
+/** Emit the pending literal if any. */
+static void flushlit( struct compiler* c ) {
+    if ( 0 == c->litlen && !c->close )
+        return;
+    emit( c, c->close ? op_close : op_lit );
+    emit( c, (int)c->litlen );
+    for( size_t i = 0; i < c->litlen; ++i )
+        emit( c, c->lit[i] );
+    c->litlen = 0;
+    c->close = 0;
+}
+
+/** Append a character to the pending literal. */
+static void litch( struct compiler* c, char ch ) {
+    if ( sizeof c->lit == c->litlen )
+        flushlit( c );
+    c->lit[ c->litlen++ ] = ch;
+}
+
+/** Append text to the pending literal. */
+static void lit( struct compiler* c, char const* text ) {
+    for( ; '\0' != *text; ++text )
+        litch( c, *text );
+}
+
+/** Append the closing character of an object or array. The trailing comma
+  * of the last value is removed here if it is in the pending literal or
+  * when the program runs otherwise. */
+static void closelit( struct compiler* c, char const* text ) {
+    if ( 0 == c->litlen )
+        c->close = 1;
+    else if ( ',' == c->lit[ c->litlen - 1 ] )
+        --c->litlen;
+    lit( c, text );
+}
+
+/** Skip spaces of the format. */
+static void skipspaces( struct compiler* c ) {
+    while( ' ' == *c->fmt || '\t' == *c->fmt || '\n' == *c->fmt || '\r' == *c->fmt )
+        ++c->fmt;
+}
+
+/** Compile a key and its colon. */
+static void key( struct compiler* c ) {
+    skipspaces( c );
+    char const* const start = c->fmt;
+    for( ; ':' != *c->fmt; ++c->fmt ) {
+        unsigned char const ch = (unsigned char)*c->fmt;
+        if ( ch < ' ' || NULL != strchr( "\"\\{}[],", ch ) ) { // Also the null character.
+            c->error = 1;
+            return;
+        }
+    }
+    if ( start == c->fmt ) {
+        c->error = 1;
+        return;
+    }
+    lit( c, "\"" );
+    for( char const* p = start; p < c->fmt; ++p )
+        litch( c, *p );
+    lit( c, "\":" );
+    ++c->fmt;
+}
+
+/** Compile the closing character of an object or array if it is next.
+  * @param c Compiler.
+  * @param close Closing character.
+  * @return Non zero if it was compiled. */
+static int closing( struct compiler* c, char close ) {
+    skipspaces( c );
+    if ( close != *c->fmt )
+        return 0;
+    ++c->fmt;
+    closelit( c, '}' == close ? "}," : "]," );
+    return 1;
+}
+
+/** Compile a value. Objects and arrays are not compiled to the end.
+  * @param c Compiler.
+  * @return The closing character of the object or array opened with items
+  *         or the null character if the value is complete. */
+static char value( struct compiler* c ) {
+    skipspaces( c );
+    char const ch = *c->fmt;
+    if ( '\0' == ch ) {
+        c->error = 1;
+        return '\0';
+    }
+    ++c->fmt;
+    if ( '{' == ch ) {
+        lit( c, "{" );
+        return closing( c, '}' ) ? '\0' : '}';
+    }
+    if ( '[' == ch ) {
+        lit( c, "[" );
+        skipspaces( c );
+        int const op = typetoop( *c->fmt );
+        char const* const next = c->fmt + 1;
+        if ( op_end == op || '*' != *next )
+            return closing( c, ']' ) ? '\0' : ']';
+        c->fmt = next + 1;
+        flushlit( c );
+        emit( c, op_array );
+        emit( c, op );
+        if ( !closing( c, ']' ) )
+            c->error = 1;
+        return '\0';
+    }
+    if ( 'n' == ch ) {
+        lit( c, "null," );
+        return '\0';
+    }
+    int const op = typetoop( ch );
+    if ( op_end == op ) {
+        c->error = 1;
+        return '\0';
+    }
+    flushlit( c );
+    emit( c, op );
+    return '\0';
+}
+
+/* Compile a pack format. */
+size_t json_packCompile( unsigned char* prog, size_t size, char const* fmt ) {
+    struct compiler c = {
+        .prog = prog,
+        .size = size,
+        .fmt  = fmt,
+    };
+    // The closing characters of the objects and arrays still open. The
+    // depth is bounded so the stack of the compiler is too.
+    char nest[ JSON_PACK_DEPTH ];
+    int depth = 0;
+    for(;;) {
+        if ( 0 != depth && '}' == nest[ depth - 1 ] )
+            key( &c );
+        char const close = c.error ? '\0' : value( &c );
+        if ( c.error )
+            break;
+        if ( '\0' != close ) {
+            if ( JSON_PACK_DEPTH == depth ) {
+                c.error = 1;
+                break;
+            }
+            nest[ depth++ ] = close;
+            continue;
+        }
+        while( 0 != depth && closing( &c, nest[ depth - 1 ] ) )
+            --depth;
+        if ( 0 == depth )
+            break;
+        if ( ',' != *c.fmt ) {
+            c.error = 1;
+            break;
+        }
+        ++c.fmt;
+    }
+    if ( !c.error ) {
+        skipspaces( &c );
+        if ( '\0' != *c.fmt )
+            c.error = 1;
+    }
+    flushlit( &c );
+    emit( &c, op_end );
+    return c.error ? 0 : c.len;
+}
+
+/** Source of the values of a program: a variable argument list or the
+  * members of a structure. */
+struct source {
+    va_list* args;
+    char const* base;
+    size_t const* offsets;
+};
+
+/** Get the next value of a source.
+  * @param src Source of values.
+  * @param vatype Type of the value in a variable argument list.
+  * @param type Type of the member in a structure. */
+#define nextval( src, vatype, type ) \
+    ( NULL == (src)->base ? (type)va_arg( *(src)->args, vatype ) : *(type const*)( (src)->base + *(src)->offsets++ ) )
+
+/** Add a signed integer value and its comma. It does not use snprintf.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param val Value to be added.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* sinteger( char* dest, long long val, size_t* remLen ) {
+    char buff[ json_numMaxLen + 1 ];
+    size_t len = json_itoa( buff, val );
+    buff[ len++ ] = ',';
+    return json_append( dest, buff, len, remLen );
+}
+
+/** Add an unsigned integer value and its comma. It does not use snprintf.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param val Value to be added.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* uinteger( char* dest, unsigned long long val, size_t* remLen ) {
+    char buff[ json_numMaxLen + 1 ];
+    size_t len = json_utoa( buff, val );
+    buff[ len++ ] = ',';
+    return json_append( dest, buff, len, remLen );
+}
+
+/** Add an item of an array.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param op Operation code of the type of the items.
+  * @param items Pointer to the first item.
+  * @param i Index of the item.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* item( char* dest, int op, void const* items, int i, size_t* remLen ) {
+    switch( op ) {
+        case op_int:      return sinteger( dest, ( (int const*)items )[i], remLen );
+        case op_uint:     return uinteger( dest, ( (unsigned const*)items )[i], remLen );
+        case op_long:     return sinteger( dest, ( (long const*)items )[i], remLen );
+        case op_ulong:    return uinteger( dest, ( (unsigned long const*)items )[i], remLen );
+        case op_verylong: return sinteger( dest, ( (long long const*)items )[i], remLen );
+        case op_double:   return json_double( dest, NULL, ( (double const*)items )[i], remLen );
+        case op_bool:     return json_bool( dest, NULL, ( (int const*)items )[i], remLen );
+        default: {
+            char const* str = ( (char const* const*)items )[i];
+            return NULL == str ? json_null( dest, NULL, remLen ) : json_str( dest, NULL, str, remLen );
+        }
+    }
+}
+
+/** Run a compiled program.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param name Pointer to null-terminated string or null for unnamed.
+  * @param pc Program made by json_packCompile().
+  * @param src Source of the values.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* run( char* dest, char const* name, unsigned char const* pc, struct source* src, size_t* remLen ) {
+    if ( NULL != name ) {
+        dest = json_append( dest, "\"", 1, remLen );
+        dest = json_append( dest, name, strlen( name ), remLen );
+        dest = json_append( dest, "\":", 2, remLen );
+    }
+    for(;;) {
+        switch( *pc++ ) {
+            case op_end:
+                return dest;
+            case op_close:
+                if ( ',' == dest[-1] ) {
+                    --dest;
+                    ++*remLen;
+                }
+                // fallthrough
+            case op_lit:
+                dest = json_append( dest, pc + 1, *pc, remLen );
+                pc += 1 + *pc;
+                break;
+            case op_array: {
+                int const op = *pc++;
+                int const qty = nextval( src, int, int );
+                void const* const items = nextval( src, void const*, void const* );
+                for( int i = 0; i < qty; ++i )
+                    dest = item( dest, op, items, i, remLen );
+                break;
+            }
+            case op_int:
+                dest = sinteger( dest, nextval( src, int, int ), remLen );
+                break;
+            case op_uint:
+                dest = uinteger( dest, nextval( src, unsigned, unsigned ), remLen );
+                break;
+            case op_long:
+                dest = sinteger( dest, nextval( src, long, long ), remLen );
+                break;
+            case op_ulong:
+                dest = uinteger( dest, nextval( src, unsigned long, unsigned long ), remLen );
+                break;
+            case op_verylong:
+                dest = sinteger( dest, nextval( src, long long, long long ), remLen );
+                break;
+            case op_double:
+                dest = json_double( dest, NULL, nextval( src, double, double ), remLen );
+                break;
+            case op_bool:
+                dest = json_bool( dest, NULL, nextval( src, int, int ), remLen );
+                break;
+            case op_str: {
+                char const* const str = nextval( src, char const*, char const* );
+                dest = NULL == str ? json_null( dest, NULL, remLen ) : json_str( dest, NULL, str, remLen );
+                break;
+            }
+        }
+    }
+}
+
+/* Add a property described by a compiled pack format in a JSON string. */
+char* json_pack( char* dest, char const* name, unsigned char const* prog, size_t* remLen, ... ) {
+    va_list args;
+    va_start( args, remLen );
+    struct source src = { .args = &args };
+    dest = run( dest, name, prog, &src, remLen );
+    va_end( args );
+    return dest;
+}
+
+/* Add a property described by a compiled pack format in a JSON string. */
+char* json_vpack( char* dest, char const* name, unsigned char const* prog, size_t* remLen, va_list args ) {
+    va_list ap;
+    va_copy( ap, args );
+    struct source src = { .args = &ap };
+    dest = run( dest, name, prog, &src, remLen );
+    va_end( ap );
+    return dest;
+}
+
+/* Add a property described by a compiled pack format in a JSON string. */
+char* json_spack( char* dest, char const* name, unsigned char const* prog, void const* src, size_t const* offsets, size_t* remLen ) {
+    struct source source = { .base = src, .offsets = offsets };
+    return run( dest, name, prog, &source, remLen );
+}
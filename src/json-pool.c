@@ -0,0 +1,261 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include <stdlib.h>
+#include <stdint.h>
+#include "json-maker/json-pool.h"
+
+#ifndef __GNUC__
+#error "The buffer pool needs the __atomic builtins of GCC or Clang."
+#endif
+
+/** Header of a buffer. */
+struct jsonPoolBuffer {
+    struct jsonPoolBuffer* next;
+    unsigned cls;
+};
+
+/** Types with the strictest alignments. */
+union align {
+    long double ld;
+    long long ll;
+    void* ptr;
+};
+
+/** Size of the header rounded up so that the buffers are aligned for any type. */
+#define HEADER_SIZE \
+    ( ( sizeof( struct jsonPoolBuffer ) + sizeof( union align ) - 1 ) / sizeof( union align ) * sizeof( union align ) )
+
+/** Class of the buffers that are too big to be pooled. */
+enum { unpooled = json_poolClasses };
+
+/** Get the class of a size.
+  * @return The smallest class that holds the size or unpooled. */
+static unsigned sizetoclass( size_t size ) {
+    unsigned cls = 0;
+    for( size_t max = json_poolMinSize; max < size; max *= 2 )
+        if ( json_poolClasses == ++cls )
+            return unpooled;
+    return cls;
+}
+
+/** Get the size of a class in bytes. */
+static size_t classtosize( unsigned cls ) {
+    return (size_t)json_poolMinSize << cls;
+}
+
+/** Push a chain of buffers in a global list.
+  * Pushes and takes of the whole list are safe without the ABA problem
+  * because no thread reads the next pointer of the head. */
+static void pushchain( struct jsonPool* pool, unsigned cls, struct jsonPoolBuffer* first, struct jsonPoolBuffer* last ) {
+    struct jsonPoolBuffer* old = __atomic_load_n( &pool->head[ cls ], __ATOMIC_RELAXED );
+    do
+        last->next = old;
+    while( !__atomic_compare_exchange_n( &pool->head[ cls ], &old, first, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) );
+}
+
+/** Take all the buffers of a global list. */
+static struct jsonPoolBuffer* takeall( struct jsonPool* pool, unsigned cls ) {
+    return __atomic_exchange_n( &pool->head[ cls ], NULL, __ATOMIC_ACQUIRE );
+}
+
+/** Put back a chain of buffers taken from a global list. The length of the
+  * chain is not known, so it is stored only while the list is empty. The
+  * buffers pushed by other threads in the meantime are taken and linked in
+  * front of it, so only they are walked. */
+static void putback( struct jsonPool* pool, unsigned cls, struct jsonPoolBuffer* rest ) {
+    while( NULL != rest ) {
+        struct jsonPoolBuffer* empty = NULL;
+        if ( __atomic_compare_exchange_n( &pool->head[ cls ], &empty, rest, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) )
+            return;
+        struct jsonPoolBuffer* const pushed = takeall( pool, cls );
+        if ( NULL == pushed )
+            continue;
+        struct jsonPoolBuffer* last = pushed;
+        while( NULL != last->next )
+            last = last->next;
+        last->next = rest;
+        rest = pushed;
+    }
+}
+
+/** Take a batch of buffers of a global list. The list is taken whole and
+  * the buffers after the batch are put back at once, so the cost does not
+  * depend on the length of the list.
+  * @param pool Pool of the list.
+  * @param cls Class of the buffers.
+  * @param qty Destination of the number of buffers of the batch.
+  * @return The first buffer of the batch or null if the list is empty. */
+static struct jsonPoolBuffer* takebatch( struct jsonPool* pool, unsigned cls, unsigned* qty ) {
+    enum { batch = json_poolCacheMax / 2 };
+    struct jsonPoolBuffer* const first = takeall( pool, cls );
+    *qty = 0;
+    if ( NULL == first )
+        return NULL;
+    struct jsonPoolBuffer* last = first;
+    for( *qty = 1; *qty < batch && NULL != last->next; ++*qty )
+        last = last->next;
+    struct jsonPoolBuffer* const rest = last->next;
+    last->next = NULL;
+    putback( pool, cls, rest );
+    return first;
+}
+
+/** Allocate a new buffer of a class.
+  * @return The buffer or null if there is no memory or size is too large. */
+static struct jsonPoolBuffer* alloc( unsigned cls, size_t size ) {
+    if ( unpooled == cls && SIZE_MAX - HEADER_SIZE < size )
+        return NULL;
+    struct jsonPoolBuffer* hdr = malloc( HEADER_SIZE + ( unpooled == cls ? size : classtosize( cls ) ) );
+    if ( NULL != hdr )
+        hdr->cls = cls;
+    return hdr;
+}
+
+/** Count a buffer that is being used and update the high-water mark. */
+static void count( struct jsonPool* pool, unsigned cls ) {
+    size_t const inuse = __atomic_add_fetch( &pool->inuse[ cls ], 1, __ATOMIC_RELAXED );
+    size_t max = __atomic_load_n( &pool->highwater[ cls ], __ATOMIC_RELAXED );
+    while( inuse > max && !__atomic_compare_exchange_n( &pool->highwater[ cls ], &max, inuse, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) );
+}
+
+/* Initialize a pool. */
+void json_poolInit( struct jsonPool* pool ) {
+    for( unsigned i = 0; i < json_poolClasses; ++i ) {
+        pool->head[i] = NULL;
+        pool->inuse[i] = 0;
+        pool->highwater[i] = 0;
+    }
+}
+
+/* Free the buffers of a pool. */
+void json_poolFree( struct jsonPool* pool ) {
+    for( unsigned i = 0; i < json_poolClasses; ++i ) {
+        struct jsonPoolBuffer* hdr = takeall( pool, i );
+        while( NULL != hdr ) {
+            struct jsonPoolBuffer* const next = hdr->next;
+            free( hdr );
+            hdr = next;
+        }
+    }
+}
+
+/* Allocate buffers in advance. */
+int json_poolReserve( struct jsonPool* pool, size_t size, size_t qty ) {
+    unsigned const cls = sizetoclass( size );
+    if ( unpooled == cls )
+        return -1;
+    for( size_t i = 0; i < qty; ++i ) {
+        struct jsonPoolBuffer* hdr = alloc( cls, 0 );
+        if ( NULL == hdr )
+            return -1;
+        pushchain( pool, cls, hdr, hdr );
+    }
+    return 0;
+}
+
+/* Get the max number of buffers of a class that were in use at once. */
+size_t json_poolHighWater( struct jsonPool const* pool, size_t size ) {
+    unsigned const cls = sizetoclass( size );
+    return unpooled == cls ? 0 : __atomic_load_n( &pool->highwater[ cls ], __ATOMIC_RELAXED );
+}
+
+/* Initialize the cache of a thread. */
+void json_poolCacheInit( struct jsonPoolCache* cache, struct jsonPool* pool ) {
+    cache->pool = pool;
+    for( unsigned i = 0; i < json_poolClasses; ++i ) {
+        cache->head[i] = NULL;
+        cache->qty[i] = 0;
+    }
+}
+
+/** Return some buffers of a class of a cache to the pool.
+  * @param cache Cache of the current thread.
+  * @param cls Class of the buffers.
+  * @param keep Number of buffers that stay in the cache. */
+static void release( struct jsonPoolCache* cache, unsigned cls, unsigned keep ) {
+    if ( keep >= cache->qty[ cls ] )
+        return;
+    struct jsonPoolBuffer** link = &cache->head[ cls ];
+    for( unsigned i = 0; i < keep; ++i )
+        link = &(*link)->next;
+    struct jsonPoolBuffer* const first = *link;
+    struct jsonPoolBuffer* last = first;
+    while( NULL != last->next )
+        last = last->next;
+    *link = NULL;
+    cache->qty[ cls ] = keep;
+    pushchain( cache->pool, cls, first, last );
+}
+
+/* Return all the buffers of a cache to its pool. */
+void json_poolCacheFlush( struct jsonPoolCache* cache ) {
+    for( unsigned i = 0; i < json_poolClasses; ++i )
+        release( cache, i, 0 );
+}
+
+/* Get a buffer. */
+char* json_poolGet( struct jsonPoolCache* cache, size_t size, size_t* capacity ) {
+    unsigned const cls = sizetoclass( size );
+    struct jsonPoolBuffer* hdr;
+    if ( unpooled == cls )
+        hdr = alloc( cls, size );
+    else {
+        if ( NULL == cache->head[ cls ] )
+            cache->head[ cls ] = takebatch( cache->pool, cls, &cache->qty[ cls ] );
+        hdr = cache->head[ cls ];
+        if ( NULL != hdr ) {
+            cache->head[ cls ] = hdr->next;
+            --cache->qty[ cls ];
+        }
+        else
+            hdr = alloc( cls, 0 );
+    }
+    if ( NULL == hdr )
+        return NULL;
+    if ( unpooled != cls )
+        count( cache->pool, cls );
+    if ( NULL != capacity )
+        *capacity = unpooled == cls ? size : classtosize( cls );
+    return (char*)hdr + HEADER_SIZE;
+}
+
+/* Return a buffer to the pool. */
+void json_poolPut( struct jsonPoolCache* cache, char* buff ) {
+    if ( NULL == buff )
+        return;
+    struct jsonPoolBuffer* hdr = (struct jsonPoolBuffer*)( buff - HEADER_SIZE );
+    unsigned const cls = hdr->cls;
+    if ( unpooled == cls ) {
+        free( hdr );
+        return;
+    }
+    __atomic_sub_fetch( &cache->pool->inuse[ cls ], 1, __ATOMIC_RELAXED );
+    hdr->next = cache->head[ cls ];
+    cache->head[ cls ] = hdr;
+    if ( ++cache->qty[ cls ] > json_poolCacheMax )
+        release( cache, cls, json_poolCacheMax / 2 );
+}
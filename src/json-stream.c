@@ -0,0 +1,83 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include "json-maker/json-stream.h"
+
+/* Close a filter and all the following stages of its chain. */
+int json_filterClose( struct jsonFilter* filter ) {
+    int rslt = 0;
+    for( ; NULL != filter; filter = filter->next )
+        if ( NULL != filter->close && 0 != filter->close( filter ) )
+            rslt = -1;
+    return rslt;
+}
+
+/* Open a stream in a window of memory. */
+char* json_streamOpen( struct jsonStream* stream, char* buff, size_t size, struct jsonFilter* out, size_t* remLen ) {
+    stream->buff  = buff;
+    stream->size  = size;
+    stream->out   = out;
+    stream->error = NULL == out || NULL == buff || size < 3;
+    // A character of the window is spare so that a remaining length of zero
+    // always means that an element did not fit.
+    *remLen = stream->error ? 0 : size - 2;
+    if ( NULL == buff )
+        return NULL;
+    *buff = '\0';
+    return buff;
+}
+
+/* Pass the text finished so far to the filter chain if the window is half full. */
+char* json_streamSync( struct jsonStream* stream, char* dest, size_t* remLen ) {
+    size_t const len = dest - stream->buff;
+    if ( 0 == *remLen )
+        stream->error = 1;
+    if ( stream->error || len <= stream->size / 2 )
+        return dest;
+    // The last character is kept in the window because json_objClose(),
+    // json_arrClose() and json_end() can remove a trailing comma.
+    if ( 0 != json_filterWrite( stream->out, stream->buff, len - 1 ) ) {
+        stream->error = 1;
+        return dest;
+    }
+    stream->buff[0] = dest[-1];
+    stream->buff[1] = '\0';
+    *remLen = stream->size - 3;
+    return stream->buff + 1;
+}
+
+/* Pass the rest of the text to the filter chain and close it. */
+int json_streamClose( struct jsonStream* stream, char* dest, size_t* remLen ) {
+    size_t const len = dest - stream->buff;
+    if ( 0 == *remLen )
+        stream->error = 1;
+    if ( !stream->error && 0 != len && 0 != json_filterWrite( stream->out, stream->buff, len ) )
+        stream->error = 1;
+    if ( 0 != json_filterClose( stream->out ) )
+        stream->error = 1;
+    *remLen = 0;
+    return stream->error ? -1 : 0;
+}
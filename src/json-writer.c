@@ -0,0 +1,145 @@
+
+/*
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2018 Rafa Garcia <rafagarcia77@gmail.com>.
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <stddef.h> // For NULL
+#include <string.h>
+#include "json-maker/json-maker.h"
+#include "json-maker/json-writer.h"
+#include "json-maker/json-num.h"
+
+/* Initialize a writer. */
+int json_writerInit( struct jsonWriter* writer, char* buff, size_t size, char* (*step)( struct jsonWriter*, char*, size_t* ), void* ctx ) {
+    writer->buff   = buff;
+    writer->size   = size;
+    writer->head   = 0;
+    writer->tail   = 0;
+    writer->step   = step;
+    writer->ctx    = ctx;
+    writer->index  = 0;
+    writer->str    = NULL;
+    writer->strLen = 0;
+    writer->strEnd = NULL;
+    writer->done   = 0;
+    // The smallest window holds a kept character and the longest escape
+    // sequence of a string.
+    writer->error  = NULL == step || size < 16;
+    return writer->error ? -1 : 0;
+}
+
+/** Add the rest of a string and its end if it fits or keep the position.
+  * @param writer Writer with a string being written.
+  * @param dest Pointer to the end of JSON under construction.
+  * @param remLen Pointer to remaining length of dest
+  * @return Pointer to the new end of JSON under construction. */
+static char* string( struct jsonWriter* writer, char* dest, size_t* remLen ) {
+    // A character is left free because a remaining length of zero means
+    // that the window overflowed.
+    size_t const room = 0 != *remLen ? *remLen - 1 : 0;
+    size_t len = room;
+    int used;
+    dest = json_escape( dest, writer->str, writer->strLen, &used, &len );
+    *remLen -= room - len;
+    writer->str += used;
+    if ( 0 <= writer->strLen )
+        writer->strLen -= used;
+    size_t const end = sizeof "\"," - 1;
+    if ( ( '\0' != *writer->str && 0 != writer->strLen ) || *remLen <= end ) {
+        writer->strEnd = dest;
+        return dest;
+    }
+    writer->str = NULL;
+    return json_append( dest, "\",", end, remLen );
+}
+
+/* Add a text property that can be longer than the window. */
+char* json_writerNstr( struct jsonWriter* writer, char* dest, char const* name, char const* value, int len, size_t* remLen ) {
+    if ( NULL != name ) {
+        dest = json_append( dest, "\"", 1, remLen );
+        dest = json_append( dest, name, strlen( name ), remLen );
+        dest = json_append( dest, "\":\"", 3, remLen );
+    }
+    else
+        dest = json_append( dest, "\"", 1, remLen );
+    writer->str = value;
+    writer->strLen = len;
+    return string( writer, dest, remLen );
+}
+
+/** Build the next part of the document at the end of the window.
+  * @param writer Writer with all the text but the kept character sent.
+  * @return Zero on success. Non zero if the part overflowed the window. */
+static int build( struct jsonWriter* writer ) {
+    // Move the kept character to the start of the window.
+    size_t const kept = writer->tail - writer->head;
+    if ( 0 != kept )
+        writer->buff[0] = writer->buff[writer->head];
+    writer->head = 0;
+    writer->tail = kept;
+    char* const dest = writer->buff + kept;
+    size_t remLen = writer->size - 1 - kept;
+    char* end;
+    if ( NULL != writer->str ) {
+        end = string( writer, dest, &remLen );
+    }
+    else {
+        end = writer->step( writer, dest, &remLen );
+        if ( NULL == end ) {
+            writer->done = 1;
+            return 0;
+        }
+        ++writer->index;
+        if ( NULL != writer->str && end != writer->strEnd )
+            return -1; // Other text was added after an unfinished string.
+    }
+    if ( 0 == remLen )
+        return -1;
+    writer->tail = end - writer->buff;
+    return 0;
+}
+
+/* Build and send the document until it is finished or the socket is full. */
+int json_writerRun( struct jsonWriter* writer, long (*send)( void* sock, void const* data, size_t len ), void* sock ) {
+    while( !writer->error ) {
+        // The last character is kept in the window until the next step because
+        // json_objClose(), json_arrClose() and json_end() can remove a trailing comma.
+        size_t const keep = writer->done || 0 == writer->tail ? 0 : 1;
+        if ( writer->tail - writer->head > keep ) {
+            size_t const len = writer->tail - keep - writer->head;
+            long const sent = send( sock, writer->buff + writer->head, len );
+            if ( 0 > sent || (size_t)sent > len ) {
+                writer->error = 1;
+                break;
+            }
+            writer->head += (size_t)sent;
+            if ( (size_t)sent < len )
+                return json_writerBlocked;
+        }
+        if ( writer->done )
+            return json_writerDone;
+        if ( 0 != build( writer ) )
+            writer->error = 1;
+    }
+    return json_writerError;
+}
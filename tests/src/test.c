@@ -28,10 +28,37 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <limits.h>
+#include <time.h>
+#include <math.h>
 #include "json-maker/json-maker.h"
+#include "json-maker/json-stream.h"
+#include "json-maker/json-pack.h"
+#include "json-maker/json-column.h"
+#include "json-maker/json-writer.h"
+#ifdef JSON_MAKER_ZLIB
+#include "json-maker/json-deflate.h"
+#endif
+#ifdef JSON_MAKER_MAP
+#include "json-maker/json-map.h"
+#endif
+#ifdef JSON_MAKER_POOL
+#include "json-maker/json-pool.h"
+#endif
+#ifdef JSON_MAKER_CACHE
+#include "json-maker/json-cache.h"
+#endif
+#ifdef TEST_THREADS
+#include <pthread.h>
+#endif
+#ifdef JSON_MAKER_ASYNC
+#include <fcntl.h>
+#include <unistd.h>
+#include "json-maker/json-async.h"
+#endif
 
 // ----------------------------------------------------- Test "framework": ---
 
@@ -66,25 +93,97 @@ static int test_suit( struct test const* tests, int numtests ) {
 
 // ----------------------------------------------------------- Unit tests: ---
 
+#ifndef JSON_MAKER_CBOR
+
 static int escape( void ) {
     char buff[512];
-    char* p = json_objOpen( buff, NULL );
-    p = json_str( p, "name", "\tHello: \"man\"\n" );
-    p = json_objClose( p );
-    p = json_end( p );
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_str( p, "name", "\tHello: \"man\"\n", &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
     printf( "\n\n%s\n\n", buff );
     static char const rslt[] = "{\"name\":\"\\tHello: \\\"man\\\"\\n\"}";
     check( p - buff == sizeof rslt - 1 );
     check( 0 == strcmp( buff, rslt ) );
+
+    // Control characters without a short escape and UTF-8 sequences.
+    rem = sizeof buff - 1;
+    p = json_str( buff, NULL, "a\x01\x1F\xC3\xA9", &rem );
+    static char const rslt2[] = "\"a\\u0001\\u001F\xC3\xA9\",";
+    check( p - buff == sizeof rslt2 - 1 );
+    check( sizeof buff - 1 - rem == sizeof rslt2 - 1 );
+    check( 0 == strcmp( buff, rslt2 ) );
+
+    // An escape sequence cut by an overflow leaves no unwritten byte.
+    memset( buff, 'x', sizeof buff );
+    rem = 5;
+    p = json_str( buff, NULL, "\x01", &rem );
+    check( 0 == rem );
+    check( p - buff == (int)strlen( buff ) );
+    check( 0 == strncmp( buff, "\"\\u00", p - buff ) );
+    done();
+}
+
+static int escapecut( void ) {
+    char buff[32];
+    int used;
+
+    // The whole string fits.
+    size_t rem = sizeof buff - 1;
+    char* p = json_escape( buff, "a\x01\"\xC3\xA9", -1, &used, &rem );
+    static char const rslt[] = "a\\u0001\\\"\xC3\xA9";
+    check( 5 == used );
+    check( p - buff == sizeof rslt - 1 );
+    check( sizeof buff - 1 - rem == sizeof rslt - 1 );
+    check( 0 == strcmp( buff, rslt ) );
+
+    // A \u00XX sequence that does not fit is not started.
+    memset( buff, 'x', sizeof buff );
+    rem = 6;
+    p = json_escape( buff, "ab\x01" "c", -1, &used, &rem );
+    check( 2 == used );
+    check( 4 == rem );
+    check( p == buff + 2 );
+    check( 0 == strcmp( buff, "ab" ) );
+    check( 'x' == buff[3] );
+
+    // The rest is added when there is room, with an exact fit.
+    rem = 7;
+    p = json_escape( p, "ab\x01" "c" + used, -1, &used, &rem );
+    check( 2 == used );
+    check( 0 == rem );
+    check( 0 == strcmp( buff, "ab\\u0001c" ) );
+
+    // A two-character sequence is not split either.
+    rem = 2;
+    p = json_escape( buff, "a\"", -1, &used, &rem );
+    check( 1 == used );
+    check( 1 == rem );
+    check( 0 == strcmp( buff, "a" ) );
+
+    // The length limits the characters used.
+    rem = sizeof buff - 1;
+    p = json_escape( buff, "a\nbc", 2, &used, &rem );
+    check( 2 == used );
+    check( 0 == strcmp( buff, "a\\n" ) );
+
+    // Without room nothing is used.
+    rem = 0;
+    p = json_escape( buff, "\t", -1, &used, &rem );
+    check( 0 == used );
+    check( p == buff );
+    check( '\0' == *buff );
     done();
 }
 
 static int len( void ) {
     char buff[512];
-    char* p = json_objOpen( buff, NULL );
-    p = json_nstr( p, "name", "\tHello: \"man\"\n", 6 );
-    p = json_objClose( p );
-    p = json_end( p );
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_nstr( p, "name", "\tHello: \"man\"\n", 6, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
     static char const rslt[] = "{\"name\":\"\\tHello\"}";
     check( p - buff == sizeof rslt - 1 );
     check( 0 == strcmp( buff, rslt ) );
@@ -94,33 +193,36 @@ static int len( void ) {
 static int empty( void ) {
     char buff[512];
     {
-        char* p = json_objOpen( buff, NULL );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         static char const rslt[] = "{}";
         check( p - buff == sizeof rslt - 1 );
         check( 0 == strcmp( buff, rslt ) );
     }
     {
-        char* p = json_objOpen( buff, NULL );
-        p = json_arrOpen( p, "a" );
-        p = json_arrClose( p );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_arrOpen( p, "a", &rem );
+        p = json_arrClose( p, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         static char const rslt[] = "{\"a\":[]}";
         check( p - buff == sizeof rslt - 1 );
         check( 0 == strcmp( buff, rslt ) );
     }
     {
-        char* p = json_objOpen( buff, NULL );
-        p = json_arrOpen( p, "a" );
-        p = json_objOpen( p, NULL );
-        p = json_objClose( p );
-        p = json_objOpen( p, NULL );
-        p = json_objClose( p );
-        p = json_arrClose( p );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_arrOpen( p, "a", &rem );
+        p = json_objOpen( p, NULL, &rem );
+        p = json_objClose( p, &rem );
+        p = json_objOpen( p, NULL, &rem );
+        p = json_objClose( p, &rem );
+        p = json_arrClose( p, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         static char const rslt[] = "{\"a\":[{},{}]}";
         check( p - buff == sizeof rslt - 1 );
         check( 0 == strcmp( buff, rslt ) );
@@ -135,14 +237,15 @@ static int empty( void ) {
 
 static int primitive( void ) {
     char buff[512];
-    char* p = json_objOpen( buff, NULL );
-    p = json_verylong( p, "max",  LONG_LONG_MAX );
-    p = json_verylong( p, "min",  LONG_LONG_MIN );
-    p = json_bool( p, "boolvar0", 0 );
-    p = json_bool( p, "boolvar1", 1 );
-    p = json_null( p, "nullvar" );
-    p = json_objClose( p );
-    p = json_end( p );
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_verylong( p, "max",  LONG_LONG_MAX, &rem );
+    p = json_verylong( p, "min",  LONG_LONG_MIN, &rem );
+    p = json_bool( p, "boolvar0", 0, &rem );
+    p = json_bool( p, "boolvar1", 1, &rem );
+    p = json_null( p, "nullvar", &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
     static char const rslt[] =  "{"
                                     "\"max\":9223372036854775807,"
                                     "\"min\":-9223372036854775808,"
@@ -158,22 +261,24 @@ static int primitive( void ) {
 static int integers( void ) {
     {
         char buff[64];
-        char* p = json_objOpen( buff, NULL );
-        p = json_int( p, "a", 0 );
-        p = json_int( p, "b", 1 );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_int( p, "a", 0, &rem );
+        p = json_int( p, "b", 1, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         static char const rslt[] = "{\"a\":0,\"b\":1}";
         check( p - buff == sizeof rslt - 1 );
         check( 0 == strcmp( buff, rslt ) );
     }
     {
         char buff[64];
-        char* p = json_objOpen( buff, NULL );
-        p = json_int( p, "max", INT_MAX );
-        p = json_int( p, "min", INT_MIN );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_int( p, "max", INT_MAX, &rem );
+        p = json_int( p, "min", INT_MIN, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         char rslt[ sizeof buff ];
         int len = sprintf( rslt, "{\"max\":%d,\"min\":%d}", INT_MAX, INT_MIN );
         check( len < sizeof buff );
@@ -182,10 +287,11 @@ static int integers( void ) {
     }
     {
         char buff[64];
-        char* p = json_objOpen( buff, NULL );
-        p = json_uint( p, "max", UINT_MAX );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_uint( p, "max", UINT_MAX, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         char rslt[ sizeof buff ];
         int len = sprintf( rslt, "{\"max\":%u}", UINT_MAX );
         check( len < sizeof buff );
@@ -194,11 +300,12 @@ static int integers( void ) {
     }
     {
         char buff[64];
-        char* p = json_objOpen( buff, NULL );
-        p = json_long( p, "max", LONG_MAX );
-        p = json_long( p, "min", LONG_MIN );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_long( p, "max", LONG_MAX, &rem );
+        p = json_long( p, "min", LONG_MIN, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         char rslt[ sizeof buff ];
         int len = sprintf( rslt, "{\"max\":%ld,\"min\":%ld}", LONG_MAX, LONG_MIN );
         check( len < sizeof buff );
@@ -207,10 +314,11 @@ static int integers( void ) {
     }
     {
         char buff[64];
-        char* p = json_objOpen( buff, NULL );
-        p = json_ulong( p, "max", ULONG_MAX );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_ulong( p, "max", ULONG_MAX, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         char rslt[ sizeof buff ];
         int len = sprintf( rslt, "{\"max\":%lu}", ULONG_MAX );
         check( len < sizeof buff );
@@ -219,11 +327,12 @@ static int integers( void ) {
     }
     {
         char buff[64];
-        char* p = json_objOpen( buff, NULL );
-        p = json_verylong( p, "max", LONG_LONG_MAX );
-        p = json_verylong( p, "min", LONG_LONG_MIN );
-        p = json_objClose( p );
-        p = json_end( p );
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_verylong( p, "max", LONG_LONG_MAX, &rem );
+        p = json_verylong( p, "min", LONG_LONG_MIN, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
         char rslt[ sizeof buff ];
         int len = sprintf( rslt, "{\"max\":%lld,\"min\":%lld}", LONG_LONG_MAX, LONG_LONG_MIN );
         check( len < sizeof buff );
@@ -235,13 +344,14 @@ static int integers( void ) {
 
 static int array( void ) {
     char buff[64];
-    char* p = json_objOpen( buff, NULL );
-    p = json_arrOpen( p, "a" );
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_arrOpen( p, "a", &rem );
     for( int i = 0; i < 4; ++i )
-        p = json_int( p, NULL, i );
-    p = json_arrClose( p );
-    p = json_objClose( p );
-    p = json_end( p );
+        p = json_int( p, NULL, i, &rem );
+    p = json_arrClose( p, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
     static char const rslt[] = "{\"a\":[0,1,2,3]}";
     check( p - buff == sizeof rslt - 1 );
     check( 0 == strcmp( buff, rslt ) );
@@ -250,37 +360,1213 @@ static int array( void ) {
 
 static int real( void ) {
     char buff[64];
-    char* p = json_objOpen( buff, NULL );
-    p = json_arrOpen( p, "data" );
-    static double const lut[] = { 0.2, 2e-6, 5e6 };
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_arrOpen( p, "data", &rem );
+    static double const lut[] = { 0.2, 2e-6, 5e6, 100, -1234567, 0.0001 };
     for( int i = 0; i < sizeof lut / sizeof *lut; ++i )
-        p = json_double( p, NULL, lut[i] );
-    p = json_arrClose( p );
-    p = json_objClose( p );
-    p = json_end( p );
-#ifdef NO_SPRINTF
-    static char const rslt1[] = "{\"data\":[0,0,5000000]}";
-    static char const rslt2[] = "{\"data\":[0,0,5000000]}";
-#else
-    static char const rslt1[] = "{\"data\":[0.2,2e-006,5e+006]}";
-    static char const rslt2[] = "{\"data\":[0.2,2e-06,5e+06]}";
-#endif
+        p = json_double( p, NULL, lut[i], &rem );
+    p = json_arrClose( p, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
+    static char const rslt1[] = "{\"data\":[0.2,2e-006,5e+006,100,-1.23457e+006,0.0001]}";
+    static char const rslt2[] = "{\"data\":[0.2,2e-06,5e+06,100,-1.23457e+06,0.0001]}";
     check( p - buff == sizeof rslt1 - 1 || p - buff == sizeof rslt2 - 1 );
     check( 0 == strcmp( buff, rslt1 ) ||  0 == strcmp( buff, rslt2 ) );
     done();
 }
 
+static int timestamp( void ) {
+    {
+        char buff[128];
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_timestamp( p, "a", 0, 0, &rem );
+        p = json_timestamp( p, "b", -1, 9, &rem );
+        p = json_timestamp( p, "c", INT64_C(1792326896123456789), 6, &rem );
+        p = json_timestamp( p, NULL, INT64_C(951782400000000000), 3, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
+        static char const rslt[] =  "{"
+                                        "\"a\":\"1970-01-01T00:00:00Z\","
+                                        "\"b\":\"1969-12-31T23:59:59.999999999Z\","
+                                        "\"c\":\"2026-10-18T12:34:56.123456Z\","
+                                        "\"2000-02-29T00:00:00.000Z\""
+                                    "}";
+        check( p - buff == sizeof rslt - 1 );
+        check( 0 == strcmp( buff, rslt ) );
+    }
+    {
+        // The date of the last call is cached. Calls on the same day reuse it
+        // and calls after midnight must not.
+        static struct { int64_t secs; char const* rslt; } const calls[] = {
+            { INT64_C(1792367999), "\"2026-10-18T23:59:59Z\"," },
+            { INT64_C(1792281600), "\"2026-10-18T00:00:00Z\"," },
+            { INT64_C(1792368000), "\"2026-10-19T00:00:00Z\"," },
+            { INT64_C(1792368001), "\"2026-10-19T00:00:01Z\"," },
+            { INT64_C(1792367999), "\"2026-10-18T23:59:59Z\"," },
+            { INT64_C(-1),         "\"1969-12-31T23:59:59Z\"," },
+            { INT64_C(0),          "\"1970-01-01T00:00:00Z\"," },
+        };
+        for( int i = 0; i < (int)( sizeof calls / sizeof *calls ); ++i ) {
+            char buff[64];
+            size_t rem = sizeof buff - 1;
+            char* p = json_timestamp( buff, NULL, calls[i].secs * 1000000000, 0, &rem );
+            check( p - buff == (int)strlen( calls[i].rslt ) );
+            check( 0 == strcmp( buff, calls[i].rslt ) );
+        }
+    }
+    // Compare with gmtime() along several centuries.
+    for( int64_t secs = -INT64_C(9000000000); secs < INT64_C(9000000000); secs += INT64_C(7654321) ) {
+        char buff[64];
+        size_t rem = sizeof buff - 1;
+        char* p = json_timestamp( buff, NULL, secs * 1000000000, 0, &rem );
+        time_t const t = (time_t)secs;
+        struct tm const* tm = gmtime( &t );
+        check( NULL != tm );
+        char rslt[64];
+        size_t const len = strftime( rslt, sizeof rslt, "\"%Y-%m-%dT%H:%M:%SZ\",", tm );
+        check( p - buff == len );
+        check( 0 == strcmp( buff, rslt ) );
+    }
+    done();
+}
+
+struct packed {
+    int temp;
+    unsigned hum;
+    char const* city;
+    int qty;
+    double const* samples;
+};
+
+static int pack( void ) {
+    static double const samples[] = { 0.5, -2, 25 };
+    static char const* const tags[] = { "a", "\"b\"", NULL };
+    static char const rslt[] =  "{"
+                                    "\"temp\":-5,"
+                                    "\"hum\":48,"
+                                    "\"city\":\"liverpool\","
+                                    "\"samples\":[0.5,-2,25],"
+                                    "\"fixed\":[1,null,true,{}],"
+                                    "\"tags\":[\"a\",\"\\\"b\\\"\",null],"
+                                    "\"empty\":[]"
+                                "}";
+    unsigned char prog[128];
+    char const fmt[] = "{ temp:i, hum:u, city:s, samples:[d*], fixed:[I,n,b,{}], tags:[s*], empty:[i*] }";
+    check( 0 != json_packCompile( prog, sizeof prog, fmt ) );
+    char buff[256];
+    {
+        size_t rem = sizeof buff - 1;
+        char* p = json_pack( buff, NULL, prog, &rem, -5, 48u, "liverpool", 3, samples, 1ll, 1, 3, tags, 0, NULL );
+        p = json_end( p, &rem );
+        check( p - buff == sizeof rslt - 1 );
+        check( 0 == strcmp( buff, rslt ) );
+    }
+    {
+        unsigned char prog2[128];
+        check( 0 != json_packCompile( prog2, sizeof prog2, "{temp:i,hum:u,city:s,samples:[d*]}" ) );
+        static struct packed const src = { -5, 48, "liverpool", 3, samples };
+        static size_t const offsets[] = {
+            offsetof( struct packed, temp ),
+            offsetof( struct packed, hum ),
+            offsetof( struct packed, city ),
+            offsetof( struct packed, qty ),
+            offsetof( struct packed, samples ),
+        };
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_spack( p, "a", prog2, &src, offsets, &rem );
+        p = json_pack( p, "b", prog2, &rem, -5, 48u, "liverpool", 3, samples );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
+        static char const rslt2[] = "{"
+            "\"a\":{\"temp\":-5,\"hum\":48,\"city\":\"liverpool\",\"samples\":[0.5,-2,25]},"
+            "\"b\":{\"temp\":-5,\"hum\":48,\"city\":\"liverpool\",\"samples\":[0.5,-2,25]}"
+        "}";
+        check( p - buff == sizeof rslt2 - 1 );
+        check( 0 == strcmp( buff, rslt2 ) );
+    }
+    {
+        size_t rem = sizeof buff - 1;
+        check( 0 != json_packCompile( prog, sizeof prog, "[n,[],{a:{}}]" ) );
+        char* p = json_pack( buff, NULL, prog, &rem );
+        p = json_end( p, &rem );
+        static char const rslt3[] = "[null,[],{\"a\":{}}]";
+        check( p - buff == sizeof rslt3 - 1 );
+        check( 0 == strcmp( buff, rslt3 ) );
+    }
+    {
+        size_t rem = sizeof buff - 1;
+        check( 0 != json_packCompile( prog, sizeof prog, "[i,i,u,l,L,I,I,i]" ) );
+        char* p = json_pack( buff, NULL, prog, &rem, INT_MAX, INT_MIN, UINT_MAX, LONG_MIN, ULONG_MAX, LONG_LONG_MAX, LONG_LONG_MIN, 0 );
+        p = json_end( p, &rem );
+        char rslt4[ sizeof buff ];
+        int len = sprintf( rslt4, "[%d,%d,%u,%ld,%lu,%lld,%lld,0]", INT_MAX, INT_MIN, UINT_MAX, LONG_MIN, ULONG_MAX, LONG_LONG_MAX, LONG_LONG_MIN );
+        check( p - buff == len );
+        check( 0 == strcmp( buff, rslt4 ) );
+    }
+    check( 0 == json_packCompile( prog, sizeof prog, "{a:i" ) );
+    check( 0 == json_packCompile( prog, sizeof prog, "{a:x}" ) );
+    check( 0 == json_packCompile( prog, sizeof prog, "{\"a\":i}" ) );
+    check( 0 == json_packCompile( prog, sizeof prog, "[i*,i]" ) );
+    check( 0 == json_packCompile( prog, 8, fmt ) );
+    {
+        // The nesting is bounded by JSON_PACK_DEPTH, 16 by default.
+        char deep[64];
+        size_t rem = sizeof buff - 1;
+        strcpy( deep, "[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]" );
+        check( 0 != json_packCompile( prog, sizeof prog, deep ) );
+        char* p = json_pack( buff, NULL, prog, &rem );
+        p = json_end( p, &rem );
+        check( 0 == strcmp( buff, deep ) );
+        strcpy( deep, "[{a:[{b:[{c:[{d:[{e:[{f:[{g:[{h:[i]}]}]}]}]}]}]}]}]" );
+        check( 0 == json_packCompile( prog, sizeof prog, deep ) );
+    }
+    done();
+}
+
+#ifdef JSON_MAKER_COLUMNS
+struct sample {
+    long long ts;
+    char const* city;
+};
+
+static int columns( void ) {
+    static struct sample const samples[] = { { 100, "a\"b" }, { -200, NULL }, { 300, "c" } };
+    static int const temp[] = { -5, 0, 25 };
+    static unsigned const hum[] = { 48, 50, 4000000000u };
+    static double const wind[] = { 0.5, -2, 1e+20 };
+    static int const rain[] = { 1, 0, 7 };
+    static struct jsonColumn const cols[] = {
+        { "ts",   'I', &samples->ts,   sizeof *samples },
+        { "temp", 'i', temp,           0 },
+        { "hum",  'u', hum,            0 },
+        { "wind", 'd', wind,           0 },
+        { "rain", 'b', rain,           0 },
+        { "city", 's', &samples->city, sizeof *samples },
+        { "none", 'n', temp,           0 },
+    };
+    static char const rslt[] = "{\"rows\":["
+        "{\"ts\":100,\"temp\":-5,\"hum\":48,\"wind\":0.5,\"rain\":true,\"city\":\"a\\\"b\",\"none\":null},"
+        "{\"ts\":-200,\"temp\":0,\"hum\":50,\"wind\":-2,\"rain\":false,\"city\":null,\"none\":null},"
+        "{\"ts\":300,\"temp\":25,\"hum\":4000000000,\"wind\":1e+20,\"rain\":true,\"city\":\"c\",\"none\":null}"
+    "],\"empty\":[],\"nocols\":[{},{}]}";
+    char buff[512];
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_columns( p, "rows", cols, sizeof cols / sizeof *cols, 3, &rem );
+    p = json_columns( p, "empty", cols, sizeof cols / sizeof *cols, 0, &rem );
+    p = json_columns( p, "nocols", cols, 0, 2, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
+    check( p - buff == sizeof rslt - 1 );
+    check( 0 == strcmp( buff, rslt ) );
+
+    // Many rows in several tiles and many columns out of the fast path must
+    // be written as the equivalent sequence of json_* calls.
+    static int values[1100];
+    for( int i = 0; i < 1100; ++i )
+        values[i] = i * 7 - 3000;
+    static struct jsonColumn wide[70];
+    static char names[70][4];
+    for( int i = 0; i < 70; ++i ) {
+        sprintf( names[i], "c%d", i );
+        wide[i] = (struct jsonColumn){ names[i], 'i', values + i, 0 };
+    }
+    static char expected[40000], actual[40000];
+    int const tests[][2] = { { 3, 1000 }, { 70, 10 } };
+    for( int t = 0; t < 2; ++t ) {
+        int const qty = tests[t][0], rows = tests[t][1];
+        size_t rem = sizeof expected - 1;
+        char* p = json_arrOpen( expected, NULL, &rem );
+        for( int row = 0; row < rows; ++row ) {
+            p = json_objOpen( p, NULL, &rem );
+            for( int i = 0; i < qty; ++i )
+                p = json_int( p, names[i], values[ i + row ], &rem );
+            p = json_objClose( p, &rem );
+        }
+        p = json_arrClose( p, &rem );
+        p = json_end( p, &rem );
+        check( 0 != rem );
+        rem = sizeof actual - 1;
+        p = json_columns( actual, NULL, wide, qty, rows, &rem );
+        p = json_end( p, &rem );
+        check( 0 == strcmp( expected, actual ) );
+    }
+
+    // Overflow is reported with a remaining length of zero.
+    rem = 40;
+    json_columns( buff, NULL, cols, sizeof cols / sizeof *cols, 3, &rem );
+    check( 0 == rem );
+
+    // A column without name is an error.
+    struct jsonColumn const noname[] = { { "a", 'i', temp, 0 }, { NULL, 'i', temp, 0 } };
+    rem = sizeof buff - 1;
+    p = json_columns( buff, NULL, noname, 2, 3, &rem );
+    check( 0 == rem );
+
+    // Real numbers are formatted in tiles like json_double() does.
+    static double reals[500];
+    for( int i = 0; i < 500; ++i ) {
+        double scale = 1e-20;
+        for( int e = 0; e < i % 40; ++e )
+            scale *= 10;
+        reals[i] = ( i % 7 ? 1 : -1 ) * ( i * 7919 % 100003 ) * scale / 997;
+    }
+    reals[0] = 0.0 / 0.0;
+    reals[1] = -0.0;
+    reals[2] = 1e308 * 10;
+    reals[3] = 123456.5;
+    reals[4] = 999999.5;
+    reals[5] = 1e-5;
+    static struct jsonColumn const real[] = { { "r", 'd', reals, 0 } };
+    rem = sizeof expected - 1;
+    p = json_arrOpen( expected, NULL, &rem );
+    for( int row = 0; row < 500; ++row ) {
+        p = json_objOpen( p, NULL, &rem );
+        p = json_double( p, "r", reals[ row ], &rem );
+        p = json_objClose( p, &rem );
+    }
+    p = json_arrClose( p, &rem );
+    p = json_end( p, &rem );
+    check( 0 != rem );
+    rem = sizeof actual - 1;
+    p = json_columns( actual, NULL, real, 1, 500, &rem );
+    p = json_end( p, &rem );
+    check( 0 == strcmp( expected, actual ) );
+    done();
+}
+#endif /* JSON_MAKER_COLUMNS */
+
+/** Non-blocking socket that accepts a few bytes per call and is full
+  * every fourth call. */
+struct socket {
+    char* buff;
+    size_t len;
+    size_t size;
+    unsigned calls;
+};
+
+static long socketsend( void* sock, void const* data, size_t len ) {
+    struct socket* s = sock;
+    unsigned const calls = s->calls++;
+    if ( 3 == calls % 4 )
+        return 0;
+    size_t const qty = len < 1 + calls % 11 ? len : 1 + calls % 11;
+    if ( qty > s->size - s->len )
+        return -1;
+    memcpy( s->buff + s->len, data, qty );
+    s->len += qty;
+    return (long)qty;
+}
+
+/** Text longer than the window with all kinds of escape sequences. */
+static char longtext[3000];
+
+/** Steps of a document: {"id":7,"text":"...","items":[{"n":1,"s":"..."},...],"end":true}
+  * A resumable string is the last call of its step. writerdoc() builds the
+  * same document at once. */
+static char* writerstep( struct jsonWriter* writer, char* dest, size_t* remLen ) {
+    unsigned const i = writer->index;
+    if ( 0 == i ) {
+        dest = json_objOpen( dest, NULL, remLen );
+        return json_int( dest, "id", 7, remLen );
+    }
+    if ( 1 == i )
+        return json_writerStr( writer, dest, "text", longtext, remLen );
+    if ( 2 == i )
+        return json_arrOpen( dest, "items", remLen );
+    if ( i < 83 ) {
+        if ( 0 == i % 2 )
+            return json_objClose( dest, remLen );
+        dest = json_objOpen( dest, NULL, remLen );
+        dest = json_int( dest, "n", i / 2, remLen );
+        return json_writerNstr( writer, dest, "s", "\"/\\\b\f\n\r\t\x01", i % 10, remLen );
+    }
+    if ( 83 == i ) {
+        dest = json_arrClose( dest, remLen );
+        dest = json_bool( dest, "end", 1, remLen );
+        dest = json_objClose( dest, remLen );
+        return json_end( dest, remLen );
+    }
+    return NULL;
+}
+
+static char* bigstep( struct jsonWriter* writer, char* dest, size_t* remLen ) {
+    return 0 == writer->index ? json_str( dest, NULL, "Longer than the window", remLen ) : NULL;
+}
+
+static char* writerdoc( char* dest, size_t* remLen ) {
+    dest = json_objOpen( dest, NULL, remLen );
+    dest = json_int( dest, "id", 7, remLen );
+    dest = json_str( dest, "text", longtext, remLen );
+    dest = json_arrOpen( dest, "items", remLen );
+    for( int i = 3; i < 83; i += 2 ) {
+        dest = json_objOpen( dest, NULL, remLen );
+        dest = json_int( dest, "n", i / 2, remLen );
+        dest = json_nstr( dest, "s", "\"/\\\b\f\n\r\t\x01", i % 10, remLen );
+        dest = json_objClose( dest, remLen );
+    }
+    dest = json_arrClose( dest, remLen );
+    dest = json_bool( dest, "end", 1, remLen );
+    dest = json_objClose( dest, remLen );
+    return json_end( dest, remLen );
+}
+
+static int writer( void ) {
+    for( int i = 0; i < (int)sizeof longtext - 1; ++i )
+        longtext[i] = "ab\"c\\d/\n\x02\x1F\xC3\xA9"[ i % 12 ];
+    static char expected[20000], actual[20000];
+    size_t rem = sizeof expected - 1;
+    char* p = writerdoc( expected, &rem );
+    check( 0 != rem );
+
+    // The document is sent through windows of several sizes and is
+    // the same as the one built at once.
+    static size_t const sizes[] = { 16, 17, 40, 64, 1000 };
+    for( int t = 0; t < (int)( sizeof sizes / sizeof *sizes ); ++t ) {
+        char window[1000];
+        struct jsonWriter w;
+        check( 0 == json_writerInit( &w, window, sizes[t], writerstep, NULL ) );
+        struct socket sock = { actual, 0, sizeof actual, 0 };
+        int blocked = 0, rslt;
+        while( json_writerBlocked == ( rslt = json_writerRun( &w, socketsend, &sock ) ) )
+            ++blocked;
+        check( json_writerDone == rslt );
+        check( 0 != blocked );
+        check( sock.len == (size_t)( p - expected ) );
+        check( 0 == memcmp( expected, actual, sock.len ) );
+        check( json_writerDone == json_writerRun( &w, socketsend, &sock ) );
+    }
+
+    // A window too small, a step longer than the window and a socket error.
+    char window[16];
+    struct jsonWriter w;
+    check( 0 != json_writerInit( &w, window, 15, writerstep, NULL ) );
+    struct socket sock = { actual, 0, sizeof actual, 0 };
+    check( 0 == json_writerInit( &w, window, sizeof window, bigstep, NULL ) );
+    check( json_writerError == json_writerRun( &w, socketsend, &sock ) );
+    sock = (struct socket){ actual, 0, 4, 0 };
+    check( 0 == json_writerInit( &w, window, sizeof window, writerstep, NULL ) );
+    int rslt;
+    while( json_writerBlocked == ( rslt = json_writerRun( &w, socketsend, &sock ) ) );
+    check( json_writerError == rslt );
+    check( json_writerError == json_writerRun( &w, socketsend, &sock ) );
+    done();
+}
+
+#else
+
+/** Compare a CBOR document with the expected bytes. */
+static int cborequal( char const* buff, char const* end, unsigned char const* rslt, size_t len ) {
+    return (size_t)( end - buff ) == len && 0 == memcmp( buff, rslt, len );
+}
+
+static int cborobject( void ) {
+    static unsigned char const rslt[] = {
+        0xBF, 0x61, 'a', 0x01, 0x61, 'b', 0x9F, 0x02, 0x03, 0xFF,
+        0x64, 'I', 'E', 'T', 'F', 0xBF, 0xFF, 0x61, 'c', 0x9F, 0xFF, 0xFF
+    };
+    char buff[64];
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_int( p, "a", 1, &rem );
+    p = json_arrOpen( p, "b", &rem );
+    p = json_int( p, NULL, 2, &rem );
+    p = json_int( p, NULL, 3, &rem );
+    p = json_arrClose( p, &rem );
+    p = json_objOpen( p, "IETF", &rem );
+    p = json_objClose( p, &rem );
+    p = json_arrOpen( p, "c", &rem );
+    p = json_arrClose( p, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
+    check( cborequal( buff, p, rslt, sizeof rslt ) );
+    check( rem == sizeof buff - 1 - sizeof rslt );
+    done();
+}
+
+static int cborintegers( void ) {
+    static unsigned char const rslt[] = {
+        0x9F,
+        0x00, 0x17, 0x18, 0x18, 0x18, 0x64, 0x19, 0x03, 0xE8,
+        0x1A, 0x00, 0x0F, 0x42, 0x40,
+        0x1B, 0x00, 0x00, 0x00, 0xE8, 0xD4, 0xA5, 0x10, 0x00,
+        0x20, 0x29, 0x38, 0x63, 0x39, 0x03, 0xE7,
+        0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x1A, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF
+    };
+    char buff[128];
+    size_t rem = sizeof buff - 1;
+    char* p = json_arrOpen( buff, NULL, &rem );
+    p = json_int( p, NULL, 0, &rem );
+    p = json_uint( p, NULL, 23, &rem );
+    p = json_long( p, NULL, 24, &rem );
+    p = json_ulong( p, NULL, 100, &rem );
+    p = json_int( p, NULL, 1000, &rem );
+    p = json_int( p, NULL, 1000000, &rem );
+    p = json_verylong( p, NULL, 1000000000000ll, &rem );
+    p = json_int( p, NULL, -1, &rem );
+    p = json_int( p, NULL, -10, &rem );
+    p = json_long( p, NULL, -100, &rem );
+    p = json_verylong( p, NULL, -1000, &rem );
+    p = json_verylong( p, NULL, LLONG_MIN, &rem );
+    p = json_uint( p, NULL, 0xFFFFFFFFu, &rem );
+    p = json_arrClose( p, &rem );
+    check( cborequal( buff, p, rslt, sizeof rslt ) );
+    done();
+}
+
+static int cborreal( void ) {
+    static unsigned char const rslt[] = {
+        0x9F,
+        0xF9, 0x00, 0x00, 0xF9, 0x80, 0x00, 0xF9, 0x3C, 0x00, 0xF9, 0x3E, 0x00,
+        0xF9, 0x7B, 0xFF, 0xF9, 0x00, 0x01, 0xF9, 0x04, 0x00, 0xF9, 0xC4, 0x00,
+        0xFA, 0x47, 0xC3, 0x50, 0x00, 0xFA, 0x7F, 0x7F, 0xFF, 0xFF,
+        0xFB, 0x3F, 0xF1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A,
+        0xFB, 0x7E, 0x37, 0xE4, 0x3C, 0x88, 0x00, 0x75, 0x9C,
+        0xF9, 0x7C, 0x00, 0xF9, 0xFC, 0x00, 0xF9, 0x7E, 0x00,
+        0xFF
+    };
+    static double const values[] = {
+        0.0, -0.0, 1.0, 1.5, 65504.0, 5.960464477539063e-8, 0.00006103515625, -4.0,
+        100000.0, 3.4028234663852886e+38, 1.1, 1.0e+300
+    };
+    char buff[128];
+    size_t rem = sizeof buff - 1;
+    char* p = json_arrOpen( buff, NULL, &rem );
+    for( int i = 0; i < sizeof values / sizeof *values; ++i )
+        p = json_double( p, NULL, values[i], &rem );
+    p = json_double( p, NULL, INFINITY, &rem );
+    p = json_double( p, NULL, -INFINITY, &rem );
+    p = json_double( p, NULL, NAN, &rem );
+    p = json_arrClose( p, &rem );
+    check( cborequal( buff, p, rslt, sizeof rslt ) );
+    done();
+}
+
+static int cborprimitive( void ) {
+    static unsigned char const rslt[] = {
+        0xBF,
+        0x61, 's', 0x64, 'I', 'E', 'T', 'F',
+        0x61, 'n', 0x62, 'a', '"',
+        0x61, 'e', 0x60,
+        0x61, 't', 0xF5, 0x61, 'f', 0xF4, 0x61, 'z', 0xF6,
+        0x62, 't', 's', 0xC0, 0x74, '2', '0', '1', '3', '-', '0', '3', '-', '2', '1',
+        'T', '2', '0', ':', '0', '4', ':', '0', '0', 'Z',
+        0xFF
+    };
+    char buff[128];
+    size_t rem = sizeof buff - 1;
+    char* p = json_objOpen( buff, NULL, &rem );
+    p = json_str( p, "s", "IETF", &rem );
+    p = json_nstr( p, "n", "a\"bc", 2, &rem );
+    p = json_str( p, "e", "", &rem );
+    p = json_bool( p, "t", 1, &rem );
+    p = json_bool( p, "f", 0, &rem );
+    p = json_null( p, "z", &rem );
+    p = json_timestamp( p, "ts", 1363896240ll * 1000000000, 0, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
+    check( cborequal( buff, p, rslt, sizeof rslt ) );
+
+    // A data item that does not fit is not written.
+    rem = 4;
+    p = json_str( buff, NULL, "IETF", &rem );
+    check( p == buff );
+    check( 0 == rem );
+    done();
+}
+
+#endif /* JSON_MAKER_CBOR */
+
+/** Final sink that appends the data in a memory block. */
+struct memsink {
+    struct jsonFilter filter;
+    char buff[4096];
+    size_t len;
+    int writes;
+};
+
+static int memwrite( struct jsonFilter* filter, void const* data, size_t len ) {
+    struct memsink* sink = (struct memsink*)filter;
+    if ( len > sizeof sink->buff - sink->len )
+        return -1;
+    memcpy( sink->buff + sink->len, data, len );
+    sink->len += len;
+    ++sink->writes;
+    return 0;
+}
+
+static struct jsonFilter* meminit( struct memsink* sink ) {
+    sink->filter.write = memwrite;
+    sink->filter.close = NULL;
+    sink->filter.next  = NULL;
+    sink->len = 0;
+    sink->writes = 0;
+    return &sink->filter;
+}
+
+/** Build a document with many elements.
+  * The sync function is called after each element if it is not null. */
+static char* bigdoc( char* p, char*(*sync)( void*, char*, size_t* ), void* dest, size_t* rem ) {
+    p = json_objOpen( p, NULL, rem );
+    p = json_arrOpen( p, "a", rem );
+    for( int i = 0; i < 100; ++i ) {
+        p = json_objOpen( p, NULL, rem );
+        p = json_int( p, "i", i, rem );
+        p = json_str( p, "s", "\tx", rem );
+        p = json_arrOpen( p, "e", rem );
+        p = json_arrClose( p, rem );
+        p = json_objClose( p, rem );
+        if ( sync )
+            p = sync( dest, p, rem );
+    }
+    p = json_arrClose( p, rem );
+    p = json_objClose( p, rem );
+    return json_end( p, rem );
+}
+
+static char* streamsync( void* stream, char* p, size_t* rem ) {
+    return json_streamSync( stream, p, rem );
+}
+
+static int stream( void ) {
+    static char rslt[4096];
+    size_t rem = sizeof rslt - 1;
+    char* end = bigdoc( rslt, NULL, NULL, &rem );
+    check( 0 != rem );
+    static struct memsink sink;
+    struct jsonStream stream;
+    char window[64];
+    char* p = json_streamOpen( &stream, window, sizeof window, meminit( &sink ), &rem );
+    p = bigdoc( p, streamsync, &stream, &rem );
+    check( 0 == json_streamClose( &stream, p, &rem ) );
+    check( 1 < sink.writes );
+    check( sink.len == end - rslt );
+    check( 0 == memcmp( sink.buff, rslt, sink.len ) );
+    p = json_streamOpen( &stream, window, 8, meminit( &sink ), &rem );
+    p = bigdoc( p, streamsync, &stream, &rem );
+    check( 0 != json_streamClose( &stream, p, &rem ) );
+
+#ifndef JSON_MAKER_CBOR
+    // An element that fits leaves the spare character and an element that
+    // does not fit leaves a remaining length of zero.
+    p = json_streamOpen( &stream, window, 16, meminit( &sink ), &rem );
+    check( 14 == rem );
+    p = json_str( p, NULL, "0123456789", &rem );
+    check( 1 == rem );
+    p = json_end( p, &rem );
+    check( 0 == json_streamClose( &stream, p, &rem ) );
+    check( 12 == sink.len && 0 == memcmp( sink.buff, "\"0123456789\"", 12 ) );
+    p = json_streamOpen( &stream, window, 16, meminit( &sink ), &rem );
+    p = json_str( p, NULL, "0123456789a", &rem );
+    check( 0 == rem );
+    check( 0 != json_streamClose( &stream, p, &rem ) );
+#endif
+    json_streamOpen( &stream, window, 2, meminit( &sink ), &rem );
+    check( 0 == rem );
+    check( 0 != json_streamClose( &stream, window, &rem ) );
+    done();
+}
+
+#ifdef JSON_MAKER_ZLIB
+
+static int deflatefilter( void ) {
+    static char rslt[4096];
+    size_t rem = sizeof rslt - 1;
+    char* end = bigdoc( rslt, NULL, NULL, &rem );
+    static struct memsink sink;
+    struct jsonDeflate df;
+    unsigned char zbuff[16];
+    struct jsonFilter* out = json_deflateInit( &df, Z_BEST_COMPRESSION, 0, zbuff, sizeof zbuff, meminit( &sink ) );
+    check( NULL != out );
+    struct jsonStream stream;
+    char window[128];
+    char* p = json_streamOpen( &stream, window, sizeof window, out, &rem );
+    p = bigdoc( p, streamsync, &stream, &rem );
+    check( 0 == json_streamClose( &stream, p, &rem ) );
+    check( sink.len < end - rslt );
+    static unsigned char text[4096];
+    uLongf textlen = sizeof text;
+    check( Z_OK == uncompress( text, &textlen, (unsigned char*)sink.buff, sink.len ) );
+    check( textlen == end - rslt );
+    check( 0 == memcmp( text, rslt, textlen ) );
+    out = json_deflateInit( &df, Z_DEFAULT_COMPRESSION, 1, zbuff, sizeof zbuff, meminit( &sink ) );
+    p = json_streamOpen( &stream, window, sizeof window, out, &rem );
+    p = bigdoc( p, streamsync, &stream, &rem );
+    check( 0 == json_streamClose( &stream, p, &rem ) );
+    check( 0x1f == (unsigned char)sink.buff[0] && 0x8b == (unsigned char)sink.buff[1] );
+    check( NULL == json_deflateInit( &df, Z_DEFAULT_COMPRESSION, 1, NULL, sizeof zbuff, meminit( &sink ) ) );
+    check( NULL == json_deflateInit( &df, Z_DEFAULT_COMPRESSION, 1, zbuff, 0, meminit( &sink ) ) );
+    done();
+}
+
+#endif
+
+#ifdef JSON_MAKER_MAP
+
+static char* mapsync( void* map, char* p, size_t* rem ) {
+    return json_mapSync( map, p, rem );
+}
+
+/** Build an array of strings with exactly total characters. */
+static char* paddoc( char* p, char*(*sync)( void*, char*, size_t* ), void* dest, size_t total, size_t* rem ) {
+    // Each item "0123456789abcdef", has 19 characters. The last one fills
+    // the rest of [...] without the trailing comma.
+    static char pad[40];
+    size_t const qty = ( total - 4 ) / 19 - 1;
+    size_t const padlen = total - 4 - 19 * qty;
+    memset( pad, 'x', padlen );
+    pad[padlen] = '\0';
+    p = json_arrOpen( p, NULL, rem );
+    for( size_t i = 0; i < qty; ++i ) {
+        p = json_str( p, NULL, "0123456789abcdef", rem );
+        if ( sync )
+            p = sync( dest, p, rem );
+    }
+    p = json_str( p, NULL, pad, rem );
+    p = json_arrClose( p, rem );
+    return json_end( p, rem );
+}
+
+static int mapfile( void ) {
+    static char rslt[4096];
+    size_t rem = sizeof rslt - 1;
+    char* end = bigdoc( rslt, NULL, NULL, &rem );
+    static char const path[] = "json_maker_map_test.json";
+    struct jsonMap map;
+    char* p = json_mapOpen( &map, path, 1, &rem );
+    check( NULL != p );
+    p = bigdoc( p, mapsync, &map, &rem );
+    check( 0 == json_mapClose( &map, p, &rem, json_mapAsync ) );
+    static char text[4096];
+    FILE* file = fopen( path, "rb" );
+    check( NULL != file );
+    size_t const len = fread( text, 1, sizeof text, file );
+    fclose( file );
+    remove( path );
+    check( len == end - rslt );
+    check( 0 == memcmp( text, rslt, len ) );
+
+    // Documents that end exactly on a window boundary, the second one with
+    // its pages dropped from the page cache.
+    static int const flags[] = { 0, json_mapAsync | json_mapDontNeed };
+    for( int i = 0; i < 2; ++i ) {
+        enum { window = 16 * 1024 };
+        size_t const total = ( i + 1 ) * window;
+        static char expected[ 2 * window + 1 ], actual[ 2 * window + 1 ];
+        rem = sizeof expected - 1;
+        end = paddoc( expected, NULL, NULL, total, &rem );
+        check( total == (size_t)( end - expected ) );
+        p = json_mapOpen( &map, path, window, &rem );
+        check( NULL != p );
+        p = paddoc( p, mapsync, &map, total, &rem );
+        check( 0 == json_mapClose( &map, p, &rem, flags[i] ) );
+        file = fopen( path, "rb" );
+        check( NULL != file );
+        size_t const len = fread( actual, 1, sizeof actual, file );
+        fclose( file );
+        remove( path );
+        check( len == total );
+        check( 0 == memcmp( actual, expected, len ) );
+    }
+
+    // An element that fits leaves the spare character and an element that
+    // does not fit leaves a remaining length of zero.
+    p = json_mapOpen( &map, path, 1, &rem );
+    check( NULL != p );
+    size_t const size = rem + 2;
+    char* const str = malloc( size );
+    check( NULL != str );
+    memset( str, 'x', rem - 4 );
+    str[ rem - 4 ] = '\0';
+    p = json_str( p, NULL, str, &rem );
+    check( 1 == rem );
+    p = json_mapSync( &map, p, &rem );
+    p = json_end( p, &rem );
+    check( 0 == json_mapClose( &map, p, &rem, 0 ) );
+    file = fopen( path, "rb" );
+    check( NULL != file );
+    static char exact[ 64 * 1024 ];
+    size_t const n = fread( exact, 1, sizeof exact, file );
+    fclose( file );
+    check( size - 4 == n );
+    check( '"' == exact[0] && 'x' == exact[1] && '"' == exact[ n - 1 ] );
+    p = json_mapOpen( &map, path, 1, &rem );
+    check( NULL != p );
+    memset( str, 'x', rem - 3 );
+    str[ rem - 3 ] = '\0';
+    p = json_str( p, NULL, str, &rem );
+    check( 0 == rem );
+    check( 0 != json_mapClose( &map, p, &rem, 0 ) );
+    free( str );
+    remove( path );
+    done();
+}
+
+#endif
+
+#ifdef JSON_MAKER_ASYNC
+
+static char* asyncsync( void* async, char* p, size_t* rem ) {
+    return json_asyncSync( async, p, rem );
+}
+
+static int asyncsink( void ) {
+    static char rslt[4096];
+    size_t rem = sizeof rslt - 1;
+    char* end = bigdoc( rslt, NULL, NULL, &rem );
+    static char text[4096];
+    static char mem[3][64];
+    struct jsonAsync async;
+    {
+        static char const path[] = "json_maker_async_test.json";
+        int fd = open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+        check( 0 <= fd );
+        check( 1 == write( fd, " ", 1 ) );
+        char* p = json_asyncOpen( &async, fd, mem[0], sizeof mem[0], 3, &rem );
+        check( NULL != p );
+        p = bigdoc( p, asyncsync, &async, &rem );
+        check( 0 == json_asyncClose( &async, p, &rem ) );
+        check( 1 + end - rslt == lseek( fd, 0, SEEK_CUR ) );
+        check( 1 == lseek( fd, 1, SEEK_SET ) );
+        ssize_t const len = read( fd, text, sizeof text );
+        close( fd );
+        remove( path );
+        check( len == end - rslt );
+        check( 0 == memcmp( text, rslt, len ) );
+    }
+    {
+        int fd[2];
+        check( 0 == pipe( fd ) );
+        char* p = json_asyncOpen( &async, fd[1], mem[0], sizeof mem[0], 2, &rem );
+        check( NULL != p );
+        p = bigdoc( p, asyncsync, &async, &rem );
+        check( 0 == json_asyncClose( &async, p, &rem ) );
+        close( fd[1] );
+        ssize_t len = 0;
+        for( ssize_t n; 0 < ( n = read( fd[0], text + len, sizeof text - len ) ); len += n );
+        close( fd[0] );
+        check( len == end - rslt );
+        check( 0 == memcmp( text, rslt, len ) );
+    }
+    {
+        // An element that fits leaves the spare character and an element
+        // that does not fit leaves a remaining length of zero.
+        int fd[2];
+        check( 0 == pipe( fd ) );
+        char* p = json_asyncOpen( &async, fd[1], mem[0], 16, 2, &rem );
+        check( 14 == rem );
+        p = json_str( p, NULL, "0123456789", &rem );
+        check( 1 == rem );
+        p = json_end( p, &rem );
+        check( 0 == json_asyncClose( &async, p, &rem ) );
+        check( 12 == read( fd[0], text, sizeof text ) );
+        check( 0 == memcmp( text, "\"0123456789\"", 12 ) );
+        p = json_asyncOpen( &async, fd[1], mem[0], 16, 2, &rem );
+        p = json_str( p, NULL, "0123456789a", &rem );
+        check( 0 == rem );
+        check( 0 != json_asyncClose( &async, p, &rem ) );
+        check( NULL == json_asyncOpen( &async, fd[1], mem[0], 2, 2, &rem ) );
+        close( fd[0] );
+        close( fd[1] );
+    }
+    {
+        // A failed write is reported by a later sync, not only at the close.
+        static char const path[] = "json_maker_async_fail.json";
+        int fd = open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+        check( 0 <= fd );
+        close( fd );
+        fd = open( path, O_RDONLY );
+        check( 0 <= fd );
+        char* p = json_asyncOpen( &async, fd, mem[0], sizeof mem[0], 2, &rem );
+        check( NULL != p );
+        p = json_arrOpen( p, NULL, &rem );
+        int i;
+        for( i = 0; i < 1000 && 0 != rem; ++i ) {
+            p = json_int( p, NULL, i, &rem );
+            p = json_asyncSync( &async, p, &rem );
+        }
+        check( i < 100 );
+        check( 0 != json_asyncClose( &async, p, &rem ) );
+        close( fd );
+        remove( path );
+    }
+    {
+        // Non-blocking descriptors are rejected.
+        int fd[2];
+        check( 0 == pipe( fd ) );
+        check( 0 == fcntl( fd[1], F_SETFL, O_NONBLOCK ) );
+        rem = 1;
+        check( NULL == json_asyncOpen( &async, fd[1], mem[0], sizeof mem[0], 2, &rem ) );
+        check( 0 == rem );
+        close( fd[0] );
+        close( fd[1] );
+    }
+    done();
+}
+
+#ifdef JSON_MAKER_URING
+
+/** The sink falls back to the writer thread when io_uring cannot be set up,
+  * so the ring is checked only where the kernel allows it. */
+static int asyncring( void ) {
+    static char rslt[4096];
+    size_t rem = sizeof rslt - 1;
+    char* end = bigdoc( rslt, NULL, NULL, &rem );
+    static char text[4096];
+    static char mem[4][64];
+    static char const path[] = "json_maker_ring_test.json";
+    int fd = open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    check( 0 <= fd );
+    struct jsonAsync async;
+    char* p = json_asyncOpen( &async, fd, mem[0], sizeof mem[0], 4, &rem );
+    check( NULL != p );
+    if ( !async.uring )
+        printf( "%s", "skipped, io_uring not available " );
+    p = bigdoc( p, asyncsync, &async, &rem );
+    check( 0 == json_asyncClose( &async, p, &rem ) );
+    check( 0 == lseek( fd, 0, SEEK_SET ) );
+    ssize_t const len = read( fd, text, sizeof text );
+    close( fd );
+    remove( path );
+    check( len == end - rslt );
+    check( 0 == memcmp( text, rslt, len ) );
+    done();
+}
+
+#endif
+
+#endif
+
+#ifdef JSON_MAKER_POOL
+
+/** Check if a buffer is one of a list. */
+static int isreserved( char const* buff, char* const* list, int qty ) {
+    for( int i = 0; i < qty; ++i )
+        if ( buff == list[i] )
+            return 1;
+    return 0;
+}
+
+static int pool( void ) {
+    struct jsonPool pool;
+    json_poolInit( &pool );
+    check( 0 == json_poolReserve( &pool, 1000, 3 ) );
+    struct jsonPoolCache cache;
+    json_poolCacheInit( &cache, &pool );
+    size_t cap;
+    char* a = json_poolGet( &cache, 1000, &cap );
+    check( NULL != a && 1024 == cap );
+    char* b = json_poolGet( &cache, 10, &cap );
+    check( NULL != b && 256 == cap );
+    char* c = json_poolGet( &cache, 600, &cap );
+    check( NULL != c && 1024 == cap );
+    // Just above the largest class.
+    size_t const bigsize = ( (size_t)json_poolMinSize << ( json_poolClasses - 1 ) ) + 1;
+    char* big = json_poolGet( &cache, bigsize, &cap );
+    check( NULL != big && bigsize == cap );
+    // Sizes that overflow with the header of the buffer.
+    check( NULL == json_poolGet( &cache, SIZE_MAX, &cap ) );
+    check( NULL == json_poolGet( &cache, SIZE_MAX - 1, &cap ) );
+    check( 0 == (size_t)a % sizeof( long long ) );
+    size_t rem = cap - 1;
+    char* p = json_objOpen( a, NULL, &rem );
+    p = json_int( p, "a", 1, &rem );
+    p = json_objClose( p, &rem );
+    p = json_end( p, &rem );
+    check( 0 == strcmp( a, "{\"a\":1}" ) );
+    json_poolPut( &cache, a );
+    json_poolPut( &cache, c );
+    json_poolPut( &cache, b );
+    json_poolPut( &cache, big );
+    char* d = json_poolGet( &cache, 1024, NULL );
+    check( d == a || d == c );
+    json_poolPut( &cache, d );
+    check( 2 == json_poolHighWater( &pool, 700 ) );
+    check( 1 == json_poolHighWater( &pool, 1 ) );
+    check( 0 == json_poolHighWater( &pool, 2048 ) );
+    json_poolCacheFlush( &cache );
+
+    // A refill takes a batch and leaves the rest of the buffers to the
+    // other threads. The reserved buffers are known by their addresses.
+    enum { reserved = 20 };
+    check( 0 == json_poolReserve( &pool, 4096, reserved ) );
+    char* r[ reserved ];
+    for( int i = 0; i < reserved; ++i ) {
+        r[i] = json_poolGet( &cache, 4096, NULL );
+        check( NULL != r[i] );
+    }
+    for( int i = 0; i < reserved; ++i )
+        json_poolPut( &cache, r[i] );
+    json_poolCacheFlush( &cache );
+    struct jsonPoolCache other;
+    json_poolCacheInit( &other, &pool );
+    char* e = json_poolGet( &cache, 4096, NULL );
+    check( isreserved( e, r, reserved ) );
+    // The other cache finds all the buffers that the batch left...
+    char* f[ reserved - json_poolCacheMax / 2 + 1 ];
+    int const left = (int)( sizeof f / sizeof *f ) - 1;
+    for( int i = 0; i < left; ++i ) {
+        f[i] = json_poolGet( &other, 4096, NULL );
+        check( isreserved( f[i], r, reserved ) );
+    }
+    // ...and a new one is allocated because the rest are in the first cache.
+    f[ left ] = json_poolGet( &other, 4096, NULL );
+    check( NULL != f[ left ] && !isreserved( f[ left ], r, reserved ) );
+    json_poolPut( &cache, e );
+    for( int i = 0; i <= left; ++i )
+        json_poolPut( &other, f[i] );
+    check( reserved == json_poolHighWater( &pool, 4096 ) );
+    json_poolCacheFlush( &other );
+    json_poolCacheFlush( &cache );
+    json_poolFree( &pool );
+    done();
+}
+
+#ifdef TEST_THREADS
+
+static struct jsonPool sharedpool;
+
+/** Get and put buffers. Half of them are put by the next thread. */
+static void* poolworker( void* arg ) {
+    char** exchange = arg;
+    struct jsonPoolCache cache;
+    json_poolCacheInit( &cache, &sharedpool );
+    for( int i = 0; i < 20000; ++i ) {
+        size_t const size = 100 + i % 3000;
+        char* buff = json_poolGet( &cache, size, NULL );
+        if ( NULL == buff )
+            return buff;
+        memset( buff, i, size );
+        buff = __atomic_exchange_n( exchange, buff, __ATOMIC_ACQ_REL );
+        json_poolPut( &cache, buff );
+    }
+    json_poolCacheFlush( &cache );
+    return exchange;
+}
+
+static int poolthreads( void ) {
+    json_poolInit( &sharedpool );
+    enum { qty = 4 };
+    static char* exchange[ qty ];
+    pthread_t threads[ qty ];
+    for( int i = 0; i < qty; ++i )
+        check( 0 == pthread_create( &threads[i], NULL, poolworker, &exchange[ i / 2 ] ) );
+    int failed = 0;
+    for( int i = 0; i < qty; ++i ) {
+        void* rslt;
+        pthread_join( threads[i], &rslt );
+        failed |= NULL == rslt;
+    }
+    check( !failed );
+    struct jsonPoolCache cache;
+    json_poolCacheInit( &cache, &sharedpool );
+    for( int i = 0; i < qty; ++i )
+        json_poolPut( &cache, exchange[i] );
+    json_poolCacheFlush( &cache );
+    for( size_t size = json_poolMinSize; size <= 4096; size *= 2 )
+        check( 0 != json_poolHighWater( &sharedpool, size ) );
+    json_poolFree( &sharedpool );
+    done();
+}
+
+#endif
+
+#endif
+
+#ifdef JSON_MAKER_CACHE
+
+/** Source of a cached value. */
+struct meta {
+    unsigned generation;
+    int builds;
+    int items;
+};
+
+/** Add a value with many copies of a generation.
+  * "name":{"gen":[7,7,7]}, */
+static char* genvalue( char* dest, char const* name, unsigned gen, int items, size_t* remLen ) {
+    dest = json_objOpen( dest, name, remLen );
+    dest = json_arrOpen( dest, "gen", remLen );
+    for( int i = 0; i < items; ++i )
+        dest = json_uint( dest, NULL, gen, remLen );
+    dest = json_arrClose( dest, remLen );
+    return json_objClose( dest, remLen );
+}
+
+/** Build the value of the current generation. */
+static char* json_meta( char* dest, char const* name, void* ctx, size_t* remLen ) {
+    struct meta* meta = ctx;
+    __atomic_add_fetch( &meta->builds, 1, __ATOMIC_RELAXED );
+    unsigned const gen = __atomic_load_n( &meta->generation, __ATOMIC_RELAXED );
+    return genvalue( dest, name, gen, meta->items, remLen );
+}
+
+static int cache( void ) {
+    struct meta meta = { .generation = 7, .items = 3 };
+    static char mem[128];
+    struct jsonCache cache;
+    check( 0 == json_cacheInit( &cache, mem, sizeof mem, json_meta, &meta ) );
+    char buff[256];
+    for( int i = 0; i < 3; ++i ) {
+        size_t rem = sizeof buff - 1;
+        char* p = json_objOpen( buff, NULL, &rem );
+        p = json_int( p, "a", 1, &rem );
+        p = json_cache( p, "meta", &cache, 1, &rem );
+        p = json_cache( p, NULL, &cache, 1, &rem );
+        p = json_objClose( p, &rem );
+        p = json_end( p, &rem );
+        check( 0 == strcmp( buff, "{\"a\":1,\"meta\":{\"gen\":[7,7,7]},{\"gen\":[7,7,7]}}" ) );
+        check( 1 == meta.builds );
+    }
+    meta.generation = 8;
+    size_t rem = sizeof buff - 1;
+    char* p = json_cache( buff, NULL, &cache, 2, &rem );
+    p = json_end( p, &rem );
+    check( 0 == strcmp( buff, "{\"gen\":[8,8,8]}" ) );
+    check( 2 == meta.builds );
+
+    // A value that does not fit in a slot is built every time.
+    meta.items = 30;
+    for( int i = 0; i < 2; ++i ) {
+        rem = sizeof buff - 1;
+        p = json_cache( buff, NULL, &cache, 3, &rem );
+        check( 0 != rem );
+        check( 70 == strlen( buff ) );
+    }
+    check( 4 == meta.builds );
+    check( 0 != json_cacheInit( &cache, mem, 2, json_meta, &meta ) );
+    done();
+}
+
+#ifdef TEST_THREADS
+
+static struct meta sharedmeta = { .generation = 1, .items = 50 };
+static struct jsonCache sharedcache;
+
+/** Generation asked for by the reader of the current thread. */
+static __thread unsigned wanted;
+
+/** Build the value of the generation asked for by the calling reader, not
+  * the current one, so a value is always cached under its own version. */
+static char* json_wanted( char* dest, char const* name, void* ctx, size_t* remLen ) {
+    struct meta* meta = ctx;
+    __atomic_add_fetch( &meta->builds, 1, __ATOMIC_RELAXED );
+    return genvalue( dest, name, wanted, meta->items, remLen );
+}
+
+/** Check that all the copies of the generation of a value are the expected one. */
+static int consistent( char const* text, unsigned expected ) {
+    char const* p = strchr( text, '[' );
+    if ( NULL == p )
+        return 0;
+    int qty = 0;
+    for( ++p; ']' != *p; ++qty ) {
+        char* end;
+        unsigned long const gen = strtoul( p, &end, 10 );
+        if ( end == p || gen != expected )
+            return 0;
+        p = ',' == *end ? end + 1 : end;
+    }
+    return sharedmeta.items == qty;
+}
+
+/** Read the cache many times while the generation changes. A hit must
+  * return the value of the requested version. */
+static void* cachereader( void* arg ) {
+    (void)arg;
+    char buff[512];
+    for( int i = 0; i < 20000; ++i ) {
+        unsigned const gen = __atomic_load_n( &sharedmeta.generation, __ATOMIC_RELAXED );
+        wanted = gen;
+        size_t rem = sizeof buff - 1;
+        json_cache( buff, "m", &sharedcache, gen, &rem );
+        if ( 0 == rem || !consistent( buff, gen ) )
+            return NULL;
+    }
+    return &sharedcache;
+}
+
+static int cachethreads( void ) {
+    static char mem[1024];
+    check( 0 == json_cacheInit( &sharedcache, mem, sizeof mem, json_wanted, &sharedmeta ) );
+    enum { qty = 4 };
+    pthread_t threads[ qty ];
+    for( int i = 0; i < qty; ++i )
+        check( 0 == pthread_create( &threads[i], NULL, cachereader, NULL ) );
+    for( int i = 0; i < 1000; ++i ) {
+        __atomic_add_fetch( &sharedmeta.generation, 1, __ATOMIC_RELAXED );
+        for( volatile int j = 0; j < 2000; ++j );
+    }
+    int failed = 0;
+    for( int i = 0; i < qty; ++i ) {
+        void* rslt;
+        pthread_join( threads[i], &rslt );
+        failed |= NULL == rslt;
+    }
+    check( !failed );
+    check( sharedmeta.builds < qty * 20000 );
+    done();
+}
+
+#endif
+
+#endif
+
 // --------------------------------------------------------- Execute tests: ---
 
 int main( void ) {
     static struct test const tests[] = {
+#ifndef JSON_MAKER_CBOR
         { escape,    "Escape characters"        },
+        { escapecut, "Escape without quotes"    },
         { len,       "Non-null-terminated"      },
         { empty,     "Empty objects and arrays" },
         { primitive, "Primitives values"        },
         { integers,  "Integers values"          },
         { array,     "Array"                    },
-        { real,      "Real"                     }
+        { real,      "Real"                     },
+        { timestamp, "Timestamp"                },
+        { pack,      "Pack format"              },
+#ifdef JSON_MAKER_COLUMNS
+        { columns,   "Columns"                  },
+#endif
+        { writer,    "Resumable writer"         },
+#else
+        { cborobject,    "CBOR maps and arrays" },
+        { cborintegers,  "CBOR integers"        },
+        { cborreal,      "CBOR floating point"  },
+        { cborprimitive, "CBOR primitives"      },
+#endif
+        { stream,    "Stream"                   },
+#ifdef JSON_MAKER_ZLIB
+        { deflatefilter, "Deflate filter"       },
+#endif
+#ifdef JSON_MAKER_MAP
+        { mapfile,   "Memory-mapped file"       },
+#endif
+#ifdef JSON_MAKER_ASYNC
+        { asyncsink, "Asynchronous sink"        },
+#ifdef JSON_MAKER_URING
+        { asyncring, "io_uring sink"            },
+#endif
+#endif
+#ifdef JSON_MAKER_POOL
+        { pool,      "Buffer pool"              },
+#ifdef TEST_THREADS
+        { poolthreads, "Buffer pool threads"    },
+#endif
+#endif
+#ifdef JSON_MAKER_CACHE
+        { cache,     "Subtree cache"            },
+#ifdef TEST_THREADS
+        { cachethreads, "Subtree cache threads" },
+#endif
+#endif
     };
     return test_suit( tests, sizeof tests / sizeof *tests );
 }